@@ -0,0 +1,480 @@
+// Host benchmark and simulation for the esp32evse component.
+//
+// Builds esp32evse.cpp against the stub ESPHome headers in stubs/ and either
+// replays AT traffic through the parser or runs the component against a
+// simulated EVSE.  See the "Host benchmark" section of the README.
+
+#include "esp32evse.h"
+#include "sim_evse.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace esphome {
+extern uint32_t bench_now_ms;
+}  // namespace esphome
+
+namespace {
+uint64_t allocation_count = 0;
+}  // namespace
+
+void *operator new(size_t size) {
+  ++allocation_count;
+  if (void *ptr = std::malloc(size == 0 ? 1 : size))
+    return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace esphome {
+namespace bench {
+
+using esp32evse::ESP32EVSEComponent;
+using EntityId = ESP32EVSEComponent::EntityId;
+using FreshnessSlot = ESP32EVSEComponent::FreshnessSlot;
+
+class BenchComponent : public ESP32EVSEComponent {
+ public:
+  using ESP32EVSEComponent::process_line_;
+  size_t queued_commands() const { return this->pending_commands_.size(); }
+  bool startup_done() const { return this->boot_stage_ == BootStage::DONE; }
+};
+
+// One of every entity, attached the way the generated code would.
+struct Entities {
+  text_sensor::TextSensor text[10];
+  sensor::Sensor sensors[17];
+  esp32evse::ESP32EVSEEnableSwitch enable;
+  esp32evse::ESP32EVSEAvailableSwitch available;
+  esp32evse::ESP32EVSERequestAuthorizationSwitch request_authorization;
+  esp32evse::ESP32EVSEEmeterThreePhaseSwitch three_phase;
+  esp32evse::ESP32EVSEChargingCurrentNumber numbers[9];
+  esp32evse::ESP32EVSEPilotFaultBinarySensor pilot_fault;
+
+  void attach(ESP32EVSEComponent &evse) {
+    evse.register_entity(EntityId::STATE, &this->text[0]);
+    evse.register_entity(EntityId::CHIP, &this->text[1]);
+    evse.register_entity(EntityId::VERSION, &this->text[2]);
+    evse.register_entity(EntityId::IDF_VERSION, &this->text[3]);
+    evse.register_entity(EntityId::BUILD_TIME, &this->text[4]);
+    evse.register_entity(EntityId::DEVICE_TIME, &this->text[5]);
+    evse.register_entity(EntityId::WIFI_STA_SSID, &this->text[6]);
+    evse.register_entity(EntityId::WIFI_STA_IP, &this->text[7]);
+    evse.register_entity(EntityId::WIFI_STA_MAC, &this->text[8]);
+    evse.register_entity(EntityId::DEVICE_NAME, &this->text[9]);
+    evse.register_entity(EntityId::TEMPERATURE_HIGH, &this->sensors[0]);
+    evse.register_entity(EntityId::TEMPERATURE_LOW, &this->sensors[1]);
+    evse.register_entity(EntityId::HEAP_USED, &this->sensors[2]);
+    evse.register_entity(EntityId::HEAP_TOTAL, &this->sensors[3]);
+    evse.register_entity(EntityId::ENERGY_CONSUMPTION, &this->sensors[4]);
+    evse.register_entity(EntityId::TOTAL_ENERGY_CONSUMPTION, &this->sensors[5]);
+    evse.register_entity(EntityId::VOLTAGE_L1, &this->sensors[6]);
+    evse.register_entity(EntityId::VOLTAGE_L2, &this->sensors[7]);
+    evse.register_entity(EntityId::VOLTAGE_L3, &this->sensors[8]);
+    evse.register_entity(EntityId::CURRENT_L1, &this->sensors[9]);
+    evse.register_entity(EntityId::CURRENT_L2, &this->sensors[10]);
+    evse.register_entity(EntityId::CURRENT_L3, &this->sensors[11]);
+    evse.register_entity(EntityId::WIFI_RSSI, &this->sensors[12]);
+    evse.register_entity(EntityId::EMETER_POWER, &this->sensors[13]);
+    evse.register_entity(EntityId::EMETER_SESSION_TIME, &this->sensors[14]);
+    evse.register_entity(EntityId::EMETER_CHARGING_TIME, &this->sensors[15]);
+    evse.register_entity(EntityId::UPTIME, &this->sensors[16]);
+    evse.register_entity(EntityId::ENABLE, &this->enable);
+    evse.register_entity(EntityId::AVAILABLE, &this->available);
+    evse.register_entity(EntityId::REQUEST_AUTHORIZATION, &this->request_authorization);
+    evse.register_entity(EntityId::EMETER_THREE_PHASE, &this->three_phase);
+    evse.register_entity(EntityId::PILOT_FAULT, &this->pilot_fault);
+    this->enable.set_parent(&evse);
+    this->available.set_parent(&evse);
+    this->request_authorization.set_parent(&evse);
+    this->three_phase.set_parent(&evse);
+
+    static const char *const NUMBER_COMMANDS[] = {"AT+CHCUR",        "AT+DEFCHCUR",     "AT+MAXCHCUR",
+                                                  "AT+CONSUMLIM",    "AT+DEFCONSUMLIM", "AT+CHTIMELIM",
+                                                  "AT+DEFCHTIMELIM", "AT+UNDERPOWERLIM", "AT+DEFUNDERPOWERLIM"};
+    static const FreshnessSlot NUMBER_SLOTS[] = {
+        FreshnessSlot::CHARGING_CURRENT,    FreshnessSlot::DEFAULT_CHARGING_CURRENT,
+        FreshnessSlot::MAXIMUM_CHARGING_CURRENT, FreshnessSlot::CONSUMPTION_LIMIT,
+        FreshnessSlot::DEFAULT_CONSUMPTION_LIMIT, FreshnessSlot::CHARGING_TIME_LIMIT,
+        FreshnessSlot::DEFAULT_CHARGING_TIME_LIMIT, FreshnessSlot::UNDER_POWER_LIMIT,
+        FreshnessSlot::DEFAULT_UNDER_POWER_LIMIT};
+    evse.register_entity(EntityId::CHARGING_CURRENT, &this->numbers[0]);
+    evse.register_entity(EntityId::DEFAULT_CHARGING_CURRENT, &this->numbers[1]);
+    evse.register_entity(EntityId::MAXIMUM_CHARGING_CURRENT, &this->numbers[2]);
+    evse.register_entity(EntityId::CONSUMPTION_LIMIT, &this->numbers[3]);
+    evse.register_entity(EntityId::DEFAULT_CONSUMPTION_LIMIT, &this->numbers[4]);
+    evse.register_entity(EntityId::CHARGING_TIME_LIMIT, &this->numbers[5]);
+    evse.register_entity(EntityId::DEFAULT_CHARGING_TIME_LIMIT, &this->numbers[6]);
+    evse.register_entity(EntityId::UNDER_POWER_LIMIT, &this->numbers[7]);
+    evse.register_entity(EntityId::DEFAULT_UNDER_POWER_LIMIT, &this->numbers[8]);
+    for (size_t i = 0; i < 9; ++i) {
+      this->numbers[i].set_command(NUMBER_COMMANDS[i]);
+      this->numbers[i].set_slot(NUMBER_SLOTS[i]);
+      this->numbers[i].set_parent(&evse);
+    }
+
+    // The Python glue requires the slot of every configured entity.
+    for (size_t i = 0; i < static_cast<size_t>(FreshnessSlot::SLOT_COUNT); ++i) {
+      if (static_cast<FreshnessSlot>(i) != FreshnessSlot::CHARGING_LIMIT_REACHED)
+        evse.require_slot(static_cast<FreshnessSlot>(i));
+    }
+  }
+};
+
+// Deterministic pseudo-random numbers so runs are comparable.
+uint32_t next_random() {
+  static uint32_t state = 1;
+  state = state * 1664525UL + 1013904223UL;
+  return state >> 8;
+}
+int random_between(int low, int high) { return low + static_cast<int>(next_random() % (high - low + 1)); }
+
+// Ten minutes of what a charging EVSE sends with the measurements subscribed
+// at 1 s and the slower keys polled.
+std::vector<std::string> synthetic_traffic() {
+  std::vector<std::string> lines;
+  char buf[64];
+  int power = 7000;
+  for (int second = 0; second < 600; ++second) {
+    power += random_between(-20, 20);
+    snprintf(buf, sizeof(buf), "+EMETERPOWER: %d", power);
+    lines.emplace_back(buf);
+    snprintf(buf, sizeof(buf), "+EMETERVOLTAGE: %d,%d,%d", random_between(229500, 231000),
+             random_between(229500, 231000), random_between(229500, 231000));
+    lines.emplace_back(buf);
+    snprintf(buf, sizeof(buf), "+EMETERCURRENT: %d,%d,%d", random_between(10000, 10300), random_between(10000, 10300),
+             random_between(10000, 10300));
+    lines.emplace_back(buf);
+    if (second % 10 == 0) {
+      lines.emplace_back("+STATE: 4");
+      snprintf(buf, sizeof(buf), "+TEMP: 2,%d,%d", random_between(3100, 3200), random_between(2900, 3000));
+      lines.emplace_back(buf);
+      snprintf(buf, sizeof(buf), "+EMETERCONSUM: %d", second * 2);
+      lines.emplace_back(buf);
+      snprintf(buf, sizeof(buf), "+EMETERSESTIME: %d", second);
+      lines.emplace_back(buf);
+      lines.emplace_back("OK");
+    }
+    if (second % 60 == 0) {
+      snprintf(buf, sizeof(buf), "+WIFISTACONN: 1,%d", random_between(-70, -55));
+      lines.emplace_back(buf);
+      snprintf(buf, sizeof(buf), "+HEAP: %d,300000", random_between(110000, 130000));
+      lines.emplace_back(buf);
+      lines.emplace_back("+EMETERTOTCONSUM: 1234567");
+      lines.emplace_back("+CHCUR: 160");
+      lines.emplace_back("+CONSUMLIM: 20000");
+      lines.emplace_back("+DEFUNDERPOWERLIM: 0");
+      lines.emplace_back("+PENDAUTH: 0");
+      lines.emplace_back("+ERROR: 0");
+      lines.emplace_back("OK");
+    }
+  }
+  return lines;
+}
+
+std::vector<std::string> read_traffic(const char *path) {
+  std::vector<std::string> lines;
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "Cannot open %s\n", path);
+    std::exit(1);
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    while (!line.empty() && (line.back() == '\r' || line.back() == '\n'))
+      line.pop_back();
+    if (!line.empty())
+      lines.push_back(line);
+  }
+  return lines;
+}
+
+std::string line_prefix(const std::string &line) {
+  const size_t colon = line.find(':');
+  return colon == std::string::npos ? line : line.substr(0, colon);
+}
+
+// Per-prefix cost of ``process_line_``, then the whole traffic through
+// ``loop()`` including line assembly from the UART.
+void run_lines(const std::vector<std::string> &traffic) {
+  constexpr size_t MIN_CALLS = 200'000;
+  BenchComponent evse;
+  Entities entities;
+  entities.attach(evse);
+  bench_now_ms = 1000;
+
+  std::vector<std::string> order;
+  std::map<std::string, std::vector<std::string>> by_prefix;
+  for (const auto &line : traffic) {
+    auto &group = by_prefix[line_prefix(line)];
+    if (group.empty())
+      order.push_back(line_prefix(line));
+    group.push_back(line);
+  }
+
+  printf("%-20s %7s %10s %12s %12s\n", "prefix", "lines", "ns/line", "allocs/line", "publish/line");
+  double weighted_ns = 0.0;
+  for (const auto &prefix : order) {
+    const auto &group = by_prefix[prefix];
+    const size_t calls = std::max(MIN_CALLS / group.size(), size_t{1}) * group.size();
+    const uint64_t allocations_before = allocation_count;
+    const uint32_t publishes_before = bench_publish_count;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+      const std::string &line = group[i % group.size()];
+      evse.process_line_(std::string_view(line));
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double ns = std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+    weighted_ns += ns * group.size();
+    printf("%-20s %7zu %10.1f %12.2f %12.2f\n", prefix.c_str(), group.size(), ns,
+           static_cast<double>(allocation_count - allocations_before) / calls,
+           static_cast<double>(bench_publish_count - publishes_before) / calls);
+  }
+  printf("traffic mix: %.1f ns/line in process_line_\n", weighted_ns / traffic.size());
+
+  std::string wire;
+  for (const auto &line : traffic)
+    wire += line + "\r\n";
+  size_t rounds = std::max(MIN_CALLS / traffic.size(), size_t{1});
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t round = 0; round < rounds; ++round) {
+    uart::bench_wire.rx = wire;
+    while (!uart::bench_wire.rx.empty())
+      evse.loop();
+    uart::bench_wire.tx.clear();
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("through loop(): %.0f lines/s\n", rounds * traffic.size() / seconds);
+}
+
+// A full refresh with each ``command_window`` once the startup queries are
+// done; the loop runs every 16 ms.
+void run_refresh() {
+  for (uint8_t window : {1, 2, 4, 8}) {
+    BenchComponent evse;
+    Entities entities;
+    entities.attach(evse);
+    evse.set_command_window(window);
+    SimulatedEVSE sim;
+    uart::bench_wire = {};
+    bench_now_ms = 0;
+    evse.setup();
+    auto step = [&](int ms) {
+      bench_now_ms = ms;
+      sim.step(ms);
+      if (ms % 16 == 0)
+        evse.loop();
+    };
+    auto idle = [&]() { return evse.queued_commands() == 0 && uart::bench_wire.rx.empty(); };
+    int start_ms = 0;
+    for (; start_ms < 20'000 && !(evse.startup_done() && idle()); ++start_ms)
+      step(start_ms);
+    // Start on a loop boundary, like an update() would.
+    start_ms = (start_ms + 15) / 16 * 16;
+    bench_now_ms = start_ms;
+    evse.force_update();
+    const size_t queued = evse.queued_commands();
+    int done_ms = -1;
+    for (int ms = 0; ms < 20'000; ++ms) {
+      step(start_ms + ms);
+      if (idle()) {
+        done_ms = ms;
+        break;
+      }
+    }
+    printf("window %u: %zu queries refreshed in %d ms\n", window, queued, done_ms);
+  }
+}
+
+// Time from setup() to the first +STATE and to the end of the startup
+// queries, with setup() at 300 ms and the loop every 16 ms.
+void run_boot() {
+  BenchComponent evse;
+  Entities entities;
+  entities.attach(evse);
+  SimulatedEVSE sim;
+  uart::bench_wire = {};
+  bench_now_ms = 300;
+  evse.setup();
+  int done_ms = -1;
+  for (int ms = 0; ms < 20'000 && done_ms < 0; ++ms) {
+    bench_now_ms = 300 + ms;
+    sim.step(ms);
+    if (ms % 16 == 0)
+      evse.loop();
+    if (evse.startup_done())
+      done_ms = 300 + ms;
+  }
+  printf("state ready %" PRIu32 " ms after boot, startup queries done at %d ms, %" PRIu32 " commands\n",
+         evse.get_time_to_first_state(), done_ms, sim.commands);
+}
+
+// Three hours of 10 s polls with timing jitter into an 8 KiB telemetry log.
+void run_telemetry() {
+  BenchComponent evse;
+  evse.set_telemetry(8192, 10'000, 0x1FF);
+  bench_now_ms = 1000;
+  evse.setup();
+  std::vector<std::pair<uint32_t, int>> written;
+  int power = 7000;
+  char buf[64];
+  for (int i = 0; i < 3 * 360; ++i) {
+    bench_now_ms = 1000 + i * 10'000 + random_between(0, 39);
+    power += random_between(-20, 20);
+    snprintf(buf, sizeof(buf), "+EMETERPOWER: %d", power);
+    evse.process_line_(buf);
+    written.emplace_back(bench_now_ms, power);
+    snprintf(buf, sizeof(buf), "+EMETERVOLTAGE: %d,%d,%d", random_between(230000, 230499),
+             random_between(229000, 229499), random_between(231000, 231499));
+    evse.process_line_(buf);
+    if (i % 6 == 0) {
+      snprintf(buf, sizeof(buf), "+TEMP: 2,%d,%d", random_between(3100, 3119), random_between(2900, 2919));
+      evse.process_line_(buf);
+    }
+  }
+  std::vector<std::pair<uint32_t, float>> kept;
+  evse.for_each_telemetry_sample(esp32evse::TelemetryChannel::POWER, 0,
+                                 [&](uint32_t time_ms, float value) { kept.emplace_back(time_ms, value); });
+  const size_t offset = written.size() - kept.size();
+  size_t mismatches = 0;
+  for (size_t i = 0; i < kept.size(); ++i) {
+    if (kept[i].first != written[offset + i].first || kept[i].second != written[offset + i].second)
+      ++mismatches;
+  }
+  const uint32_t samples = evse.get_telemetry().get_sample_count();
+  printf("power samples kept %zu of %zu, %zu differ from the input; %" PRIu32 " samples, %.2f bytes/sample\n",
+         kept.size(), written.size(), mismatches, samples, 8192.0 / samples);
+}
+
+// Ten minutes of 10 Hz power pushes against a +EMETERCONSUM counter that
+// only moves in whole Wh every 10 s, with a new session halfway through.
+void run_session_energy() {
+  BenchComponent evse;
+  sensor::Sensor session_energy;
+  evse.register_entity(EntityId::SESSION_ENERGY, &session_energy);
+  SimulatedEVSE sim;
+  uart::bench_wire = {};
+  bench_now_ms = 300;
+  evse.setup();
+  double true_wh = 0.0;
+  float last = -1.0f;
+  int decreases = 0;
+  double max_error = 0.0;
+  char buf[64];
+  for (int ms = 0; ms < 600'000; ++ms) {
+    bench_now_ms = 300 + ms;
+    const double power = 7400.0 + 300.0 * std::sin(ms / 7000.0);
+    if (ms == 300'000)
+      true_wh = 0.0;
+    true_wh += power / 3.6e6;
+    if (ms % 100 == 0) {
+      snprintf(buf, sizeof(buf), "+EMETERPOWER: %d", static_cast<int>(power));
+      sim.push(buf);
+    }
+    if (ms % 10'000 == 5000) {
+      snprintf(buf, sizeof(buf), "+EMETERCONSUM: %d", static_cast<int>(true_wh));
+      sim.push(buf);
+    }
+    sim.step(ms);
+    evse.loop();
+    if (session_energy.state != last) {
+      // The drop at the new session is expected.
+      if (session_energy.state < last && ms != 305'000)
+        ++decreases;
+      last = session_energy.state;
+      if (ms > 6000 && (ms < 300'000 || ms > 305'000))
+        max_error = std::max(max_error, std::fabs(session_energy.state - true_wh));
+    }
+  }
+  printf("session energy %.3f Wh (true %.3f Wh), max error %.3f Wh, %d decreases within a session\n",
+         session_energy.state, true_wh, max_error, decreases);
+}
+
+// A house load step from 5 A to 22 A on a 25 A fuse while charging at 32 A;
+// the EVSE draw follows its setpoint after 2 s.
+void run_load_step() {
+  BenchComponent evse;
+  Entities entities;
+  entities.attach(evse);
+  sensor::Sensor grid;
+  evse.set_grid_current_sensor(0, &grid);
+  evse.set_load_management(25.0f, 1.0f, 10'000, 10'000, 6.0f);
+  SimulatedEVSE sim;
+  sim.values["CHCUR"] = "320";
+  sim.values["MAXCHCUR"] = "320";
+  sim.values["EMETERCURRENT"] = "0,0,0";
+  uart::bench_wire = {};
+  bench_now_ms = 300;
+  evse.setup();
+  double evse_amps = 0.0;
+  double house_amps = 5.0;
+  int changes_after_step = 0;
+  std::string setpoint = sim.values["CHCUR"];
+  char buf[64];
+  for (int ms = 0; ms < 60'000; ++ms) {
+    bench_now_ms = 300 + ms;
+    if (ms == 20'000)
+      house_amps = 22.0;
+    if (ms % 2000 == 0)
+      evse_amps = std::stoi(sim.values["CHCUR"]) / 10.0;
+    if (ms % 1000 == 500) {
+      snprintf(buf, sizeof(buf), "+EMETERCURRENT: %d,0,0", static_cast<int>(evse_amps * 1000));
+      sim.push(buf);
+    }
+    sim.step(ms);
+    evse.loop();
+    if (ms % 500 == 0)
+      grid.publish_state(static_cast<float>(house_amps + evse_amps));
+    if (sim.values["CHCUR"] != setpoint) {
+      setpoint = sim.values["CHCUR"];
+      if (ms >= 20'000)
+        ++changes_after_step;
+    }
+  }
+  printf("after the step: setpoint %.1f A, %d change(s), last reaction %" PRIu32 " ms\n",
+         std::stoi(setpoint) / 10.0, changes_after_step, evse.get_load_management_reaction_time());
+}
+
+}  // namespace bench
+}  // namespace esphome
+
+int main(int argc, char **argv) {
+  using namespace esphome::bench;
+  const std::string mode = argc > 1 ? argv[1] : "all";
+  if (mode == "lines") {
+    run_lines(argc > 2 ? read_traffic(argv[2]) : synthetic_traffic());
+  } else if (mode == "refresh") {
+    run_refresh();
+  } else if (mode == "boot") {
+    run_boot();
+  } else if (mode == "telemetry") {
+    run_telemetry();
+  } else if (mode == "session-energy") {
+    run_session_energy();
+  } else if (mode == "load-step") {
+    run_load_step();
+  } else if (mode == "all") {
+    run_lines(synthetic_traffic());
+    run_refresh();
+    run_boot();
+    run_telemetry();
+    run_session_energy();
+    run_load_step();
+  } else {
+    fprintf(stderr, "usage: %s [all|lines [FILE]|refresh|boot|telemetry|session-energy|load-step]\n", argv[0]);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+// A simulated ESP32-EVSE on the other end of the UART.  Commands take their
+// wire time at 115200 baud to arrive, are answered one at a time after
+// ``processing_ms``, and the answers take their wire time back.  Queries are
+// answered with the last value written for the key, or a plausible default.
+
+#include "esphome/components/uart/uart.h"
+
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace esphome {
+namespace bench {
+
+class SimulatedEVSE {
+ public:
+  // Seconds per byte at 115200 baud, 8N1.
+  static constexpr double MS_PER_BYTE = 10.0 * 1000.0 / 115200.0;
+
+  void step(double now_ms) {
+    auto &wire = uart::bench_wire;
+    size_t newline;
+    while ((newline = wire.tx.find('\n')) != std::string::npos) {
+      this->inbox_.emplace_back(now_ms + (newline + 1) * MS_PER_BYTE, wire.tx.substr(0, newline));
+      wire.tx.erase(0, newline + 1);
+    }
+    while (!this->inbox_.empty() && this->inbox_.front().first <= now_ms && this->busy_until_ms_ <= now_ms) {
+      const std::string command = std::move(this->inbox_.front().second);
+      this->inbox_.pop_front();
+      ++this->commands;
+      this->busy_until_ms_ = now_ms + this->processing_ms;
+      std::string response = this->answer_(command);
+      const double ready_ms = this->busy_until_ms_ + response.size() * MS_PER_BYTE;
+      this->outbox_.emplace_back(ready_ms, std::move(response));
+    }
+    while (!this->outbox_.empty() && this->outbox_.front().first <= now_ms) {
+      wire.rx += this->outbox_.front().second;
+      this->outbox_.pop_front();
+    }
+  }
+
+  // Send an unsolicited line, as a subscription would.
+  void push(const std::string &line) { uart::bench_wire.rx += line + "\r\n"; }
+
+  double processing_ms{3.0};
+  std::map<std::string, std::string> values;
+  uint32_t commands{0};
+
+ protected:
+  std::string answer_(const std::string &command) {
+    if (command.compare(0, 3, "AT+") != 0)
+      return "OK\r\n";
+    const size_t equals = command.find('=');
+    if (equals != std::string::npos) {
+      if (command.compare(3, 3, "SUB") != 0)
+        this->values[command.substr(3, equals - 3)] = command.substr(equals + 1);
+      return "OK\r\n";
+    }
+    if (command.back() != '?')
+      return "OK\r\n";
+    const std::string key = command.substr(3, command.size() - 4);
+    return "+" + key + ": " + this->value_(key) + "\r\nOK\r\n";
+  }
+
+  std::string value_(const std::string &key) const {
+    auto it = this->values.find(key);
+    if (it != this->values.end())
+      return it->second;
+    if (key == "EMETERVOLTAGE" || key == "EMETERCURRENT")
+      return "230100,229800,231000";
+    if (key == "TEMP")
+      return "2,3150,2980";
+    if (key == "HEAP")
+      return "120000,300000";
+    if (key == "WIFISTACONN")
+      return "1,-61";
+    if (key == "CHIP")
+      return "\"esp32s2\",1";
+    return "1";
+  }
+
+  std::deque<std::pair<double, std::string>> inbox_;
+  std::deque<std::pair<double, std::string>> outbox_;
+  double busy_until_ms_{0.0};
+};
+
+}  // namespace bench
+}  // namespace esphome
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/entity_base.h"
+
+namespace esphome {
+
+extern uint32_t bench_publish_count;
+
+namespace binary_sensor {
+
+class BinarySensor : public EntityBase {
+ public:
+  void publish_state(bool state) {
+    this->state = state;
+    this->has_state_ = true;
+    ++bench_publish_count;
+  }
+  void publish_initial_state(bool state) {
+    this->state = state;
+    this->has_state_ = true;
+  }
+  bool has_state() const { return this->has_state_; }
+
+  bool state{false};
+
+ protected:
+  bool has_state_{false};
+};
+
+}  // namespace binary_sensor
+}  // namespace esphome
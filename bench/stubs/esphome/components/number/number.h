@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/entity_base.h"
+
+namespace esphome {
+
+extern uint32_t bench_publish_count;
+
+namespace number {
+
+class NumberTraits {
+ public:
+  void set_min_value(float min_value) { this->min_value_ = min_value; }
+  void set_max_value(float max_value) { this->max_value_ = max_value; }
+  void set_step(float step) { this->step_ = step; }
+  float get_min_value() const { return this->min_value_; }
+  float get_max_value() const { return this->max_value_; }
+  float get_step() const { return this->step_; }
+
+ protected:
+  float min_value_{0.0f};
+  float max_value_{0.0f};
+  float step_{1.0f};
+};
+
+class Number : public EntityBase {
+ public:
+  void publish_state(float state) {
+    this->state = state;
+    this->has_state_ = true;
+    ++bench_publish_count;
+  }
+  bool has_state() const { return this->has_state_; }
+  void make_call_and_set(float value) { this->control(value); }
+
+  float state{0.0f};
+  NumberTraits traits;
+
+ protected:
+  virtual void control(float value) = 0;
+
+  bool has_state_{false};
+};
+
+}  // namespace number
+}  // namespace esphome
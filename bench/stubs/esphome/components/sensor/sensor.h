@@ -0,0 +1,36 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "esphome/core/entity_base.h"
+
+namespace esphome {
+
+// Every ``publish_state`` of any entity is counted here.
+extern uint32_t bench_publish_count;
+
+namespace sensor {
+
+class Sensor : public EntityBase {
+ public:
+  void publish_state(float state) {
+    this->state = state;
+    this->has_state_ = true;
+    ++bench_publish_count;
+    for (auto &callback : this->callbacks_)
+      callback(state);
+  }
+  bool has_state() const { return this->has_state_; }
+  float get_state() const { return this->state; }
+  void add_on_state_callback(std::function<void(float)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+
+  float state{0.0f};
+
+ protected:
+  bool has_state_{false};
+  std::vector<std::function<void(float)>> callbacks_;
+};
+
+}  // namespace sensor
+}  // namespace esphome
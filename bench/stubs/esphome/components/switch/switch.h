@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/entity_base.h"
+
+namespace esphome {
+
+extern uint32_t bench_publish_count;
+
+namespace switch_ {
+
+class Switch : public EntityBase {
+ public:
+  void publish_state(bool state) {
+    this->state = state;
+    ++bench_publish_count;
+  }
+  void turn_on() { this->write_state(true); }
+  void turn_off() { this->write_state(false); }
+
+  bool state{false};
+
+ protected:
+  virtual void write_state(bool state) = 0;
+};
+
+}  // namespace switch_
+}  // namespace esphome
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "esphome/core/entity_base.h"
+
+namespace esphome {
+
+extern uint32_t bench_publish_count;
+
+namespace text_sensor {
+
+class TextSensor : public EntityBase {
+ public:
+  void publish_state(const std::string &state) {
+    this->state = state;
+    this->has_state_ = true;
+    ++bench_publish_count;
+  }
+  bool has_state() const { return this->has_state_; }
+  const std::string &get_state() const { return this->state; }
+  std::string get_raw_state() const { return this->state; }
+
+  std::string state;
+
+ protected:
+  bool has_state_{false};
+};
+
+}  // namespace text_sensor
+}  // namespace esphome
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+namespace uart {
+
+enum UARTParityOptions { UART_CONFIG_PARITY_NONE };
+
+const char *parity_to_str(UARTParityOptions parity);
+
+class UARTComponent {
+ public:
+  uint32_t get_baud_rate() const { return 115200; }
+  uint8_t get_data_bits() const { return 8; }
+  UARTParityOptions get_parity() const { return UART_CONFIG_PARITY_NONE; }
+  uint8_t get_stop_bits() const { return 1; }
+  size_t get_rx_buffer_size() { return 256; }
+};
+
+// The wire is a pair of strings: the bench appends EVSE output to ``rx`` and
+// consumes the component's commands from ``tx``.
+struct BenchWire {
+  std::string rx;
+  std::string tx;
+};
+extern BenchWire bench_wire;
+
+class UARTDevice {
+ public:
+  int available() { return static_cast<int>(bench_wire.rx.size()); }
+  bool read_array(uint8_t *data, size_t len);
+  void write_str(const char *str) { bench_wire.tx += str; }
+  void write_array(const uint8_t *data, size_t len) { bench_wire.tx.append(reinterpret_cast<const char *>(data), len); }
+  void flush() {}
+
+ protected:
+  UARTComponent *parent_{nullptr};
+};
+
+}  // namespace uart
+}  // namespace esphome
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+template<typename... Ts> class Trigger {
+ public:
+  void trigger(Ts... x) {
+    if (this->hook_)
+      this->hook_(x...);
+  }
+  void set_hook(std::function<void(Ts...)> &&hook) { this->hook_ = std::move(hook); }
+
+ protected:
+  std::function<void(Ts...)> hook_;
+};
+
+template<typename T, typename... X> class TemplatableValue {
+ public:
+  TemplatableValue() = default;
+  TemplatableValue(T value) : value_(value) {}
+  T value(X... x) const { return this->value_; }
+  bool has_value() const { return true; }
+
+ protected:
+  T value_{};
+};
+
+#define TEMPLATABLE_VALUE_(type, name) \
+ protected: \
+  TemplatableValue<type, Ts...> name##_{}; \
+\
+ public: \
+  template<typename V> void set_##name(V name) { this->name##_ = name; }
+#define TEMPLATABLE_VALUE(type, name) TEMPLATABLE_VALUE_(type, name)
+
+template<typename... Ts> class Action {
+ public:
+  virtual ~Action() = default;
+  virtual void play(const Ts &...x) {}
+  virtual void play_complex(const Ts &...x) {
+    ++this->num_running_;
+    this->play(x...);
+    this->play_next_(x...);
+  }
+  virtual void stop() {}
+  virtual bool is_running() { return this->num_running_ > 0; }
+
+ protected:
+  void play_next_(const Ts &...x) {
+    if (this->num_running_ > 0)
+      --this->num_running_;
+  }
+  void stop_complex() {}
+
+  int num_running_{0};
+};
+
+template<typename... Ts> class Condition {
+ public:
+  virtual ~Condition() = default;
+  virtual bool check(Ts... x) = 0;
+};
+
+}  // namespace esphome
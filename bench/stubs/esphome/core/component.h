@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace esphome {
+
+class Component {
+ public:
+  virtual ~Component() = default;
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual float get_setup_priority() const { return 0.0f; }
+
+ protected:
+  // There is no scheduler on the bench, so timeouts never fire.
+  void set_timeout(uint32_t timeout, std::function<void()> &&f) {}
+  void status_set_warning() {}
+  void status_clear_warning() {}
+};
+
+class PollingComponent : public Component {
+ public:
+  PollingComponent() = default;
+  PollingComponent(uint32_t update_interval) : update_interval_(update_interval) {}
+  virtual void update() = 0;
+  uint32_t get_update_interval() const { return this->update_interval_; }
+  void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+  void start_poller() {}
+  void stop_poller() {}
+
+ protected:
+  uint32_t update_interval_{0};
+};
+
+}  // namespace esphome
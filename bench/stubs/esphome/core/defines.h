@@ -0,0 +1,2 @@
+#pragma once
+// Feature defines come from the bench Makefile instead of the generated file.
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace esphome {
+
+class EntityBase {
+ public:
+  virtual ~EntityBase() = default;
+};
+
+}  // namespace esphome
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+
+// Simulated clock; the bench advances it explicitly.
+uint32_t millis();
+uint32_t micros();
+uint32_t arch_get_cpu_cycle_count();
+
+}  // namespace esphome
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdio>
+
+// Logging costs more than the parsing being measured, so it is compiled out
+// unless the bench is built with ``BENCH_LOG=1``.
+#ifdef BENCH_LOG
+#define ESP_LOG_BENCH_(...) (std::fprintf(stderr, __VA_ARGS__), std::fputc('\n', stderr))
+#else
+// Still type-checks the format and marks the arguments as used.
+#define ESP_LOG_BENCH_(...) (false ? (void) std::fprintf(stderr, __VA_ARGS__) : (void) 0)
+#endif
+
+#define ESP_LOGE(tag, ...) ESP_LOG_BENCH_(__VA_ARGS__)
+#define ESP_LOGW(tag, ...) ESP_LOG_BENCH_(__VA_ARGS__)
+#define ESP_LOGI(tag, ...) ESP_LOG_BENCH_(__VA_ARGS__)
+#define ESP_LOGD(tag, ...) ESP_LOG_BENCH_(__VA_ARGS__)
+#define ESP_LOGV(tag, ...) ESP_LOG_BENCH_(__VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) ESP_LOG_BENCH_(__VA_ARGS__)
+#define LOG_STR_ARG(s) (s)
+#define LOG_SENSOR(prefix, type, obj) ((void) (obj))
+#define LOG_BINARY_SENSOR(prefix, type, obj) ((void) (obj))
+#define LOG_TEXT_SENSOR(prefix, type, obj) ((void) (obj))
+#define LOG_UPDATE_INTERVAL(obj) ((void) (obj))
@@ -0,0 +1,4 @@
+#pragma once
+
+// Only warm start (USE_ESP32EVSE_WARM_START) uses preferences, and the bench
+// does not build it.
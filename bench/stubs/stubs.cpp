@@ -0,0 +1,43 @@
+// Definitions behind the stub ESPHome headers.  The clock is simulated: the
+// bench sets ``bench_now_ms`` and the component sees it through ``millis()``.
+
+#include "esphome/components/uart/uart.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace esphome {
+
+uint32_t bench_now_ms = 0;
+uint32_t bench_publish_count = 0;
+
+uint32_t millis() { return bench_now_ms; }
+
+// The parser statistics time real work, so these follow the host clock.
+uint32_t micros() {
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+uint32_t arch_get_cpu_cycle_count() {
+  return static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+namespace uart {
+
+BenchWire bench_wire;
+
+const char *parity_to_str(UARTParityOptions parity) { return "NONE"; }
+
+bool UARTDevice::read_array(uint8_t *data, size_t len) {
+  if (len > bench_wire.rx.size())
+    return false;
+  std::memcpy(data, bench_wire.rx.data(), len);
+  bench_wire.rx.erase(0, len);
+  return true;
+}
+
+}  // namespace uart
+}  // namespace esphome
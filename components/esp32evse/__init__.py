@@ -13,15 +13,28 @@ import esphome.codegen as cg
 # Provide validation utilities to make sure user supplied YAML configuration is
 # structurally correct before we attempt to generate any C++ code.
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 # The component communicates via UART, therefore we need to import and require
 # the UART helpers to bind the C++ object to ESPHome's UART subsystem.
-from esphome.components import uart
-from esphome.const import CONF_ID, CONF_UPDATE_INTERVAL
+from esphome.components import number, sensor, uart
+from esphome.const import (
+    CONF_COMMAND,
+    CONF_ID,
+    CONF_INTERVAL,
+    CONF_NUMBER,
+    CONF_OPTIMISTIC,
+    CONF_TIMEOUT,
+    CONF_UPDATE_INTERVAL,
+    CONF_VALUE,
+)
 
 # Make sure UART gets compiled alongside our component because we depend on it
 # both at configuration time and at runtime on the microcontroller.
 AUTO_LOAD = ["uart"]
 DEPENDENCIES = ["uart"]
+# Several chargers may hang off one node, each on its own UART; see
+# ``esp32evse_coordinator`` for polling them together.
+MULTI_CONF = True
 # Document the maintainer so users know who to reach out to for reviews.
 CODEOWNERS = ["@nagyrobi"]
 
@@ -43,21 +56,107 @@ ESP32EVSEUnsubscribeAllAction = esp32evse_ns.class_(
     automation.Action,
     cg.Parented.template(ESP32EVSEComponent),
 )
+# Response slots the component tracks freshness for; entity platforms map their
+# ``poll_interval`` option onto one of these.
+FreshnessSlot = ESP32EVSEComponent.enum("FreshnessSlot", is_class=True)
+# Entities the component publishes to.  Each platform registers the entities it
+# creates under one of these ids instead of a setter per entity.
+EntityId = ESP32EVSEComponent.enum("EntityId", is_class=True)
 ESP32EVSEForceUpdateAction = esp32evse_ns.class_(
     "ESP32EVSEForceUpdateAction",
     automation.Action,
     cg.Parented.template(ESP32EVSEComponent),
 )
+ESP32EVSETelemetryDumpAction = esp32evse_ns.class_(
+    "ESP32EVSETelemetryDumpAction",
+    automation.Action,
+    cg.Parented.template(ESP32EVSEComponent),
+)
+ESP32EVSEWriteAction = esp32evse_ns.class_(
+    "ESP32EVSEWriteAction",
+    automation.Action,
+    cg.Parented.template(ESP32EVSEComponent),
+)
+ESP32EVSESendCommandAction = esp32evse_ns.class_(
+    "ESP32EVSESendCommandAction",
+    automation.Action,
+    cg.Parented.template(ESP32EVSEComponent),
+)
+WriteTarget = ESP32EVSEComponent.enum("WriteTarget", is_class=True)
+# A single C++ class implements all the numeric entities.  It is declared here
+# rather than in ``number.py`` so ``esp32evse.write`` can refer to it.
+ESP32EVSEChargingCurrentNumber = esp32evse_ns.class_(
+    "ESP32EVSEChargingCurrentNumber", number.Number
+)
 
 CONF_ESP32EVSE_ID = "esp32evse_id"
 CONF_ON_READY = "on_ready"
+CONF_ON_STATE_READY = "on_state_ready"
+CONF_ON_FAULT_RAISED = "on_fault_raised"
+CONF_ON_FAULT_CLEARED = "on_fault_cleared"
+CONF_ON_WRITE_SUCCESS = "on_write_success"
+CONF_ON_WRITE_FAILED = "on_write_failed"
+CONF_ON_RESPONSE = "on_response"
+CONF_PARSER_STATS = "parser_stats"
+CONF_COMMAND_QUEUE_SIZE = "command_queue_size"
+CONF_COMMAND_WINDOW = "command_window"
+CONF_POLL_INTERVAL = "poll_interval"
+CONF_SUBSCRIBE = "subscribe"
+CONF_PUBLISH_FILTER = "publish_filter"
+CONF_ONLY_ON_CHANGE = "only_on_change"
+CONF_DELTA = "delta"
+CONF_MIN_INTERVAL = "min_interval"
+CONF_TELEMETRY = "telemetry"
+CONF_BUFFER_SIZE = "buffer_size"
+CONF_STREAMS = "streams"
+CONF_WINDOW = "window"
+CONF_LOAD_MANAGEMENT = "load_management"
+CONF_GRID_CURRENT_L1 = "grid_current_l1"
+CONF_GRID_CURRENT_L2 = "grid_current_l2"
+CONF_GRID_CURRENT_L3 = "grid_current_l3"
+CONF_FUSE_LIMIT = "fuse_limit"
+CONF_HYSTERESIS = "hysteresis"
+CONF_MIN_CHANGE_INTERVAL = "min_change_interval"
+CONF_FAILSAFE_CURRENT = "failsafe_current"
+CONF_WARM_START = "warm_start"
+CONF_SAVE_INTERVAL = "save_interval"
 
 MIN_UPDATE_INTERVAL_MS = 10_000
 MAX_UPDATE_INTERVAL_MS = 600_000
 
+# Mirrors ``ESP32EVSEComponent::POLL_EVERY_UPDATE`` and ``POLL_ONCE``.
+POLL_EVERY_UPDATE = 0
+POLL_ONCE = 0xFFFFFFFF
+MIN_SUBSCRIPTION_PERIOD_MS = 100
+
+# The queue stores one-byte slot indices, which caps its capacity at 255.  The
+# lower bound still fits the ~37 command burst of a forced refresh.
+DEFAULT_COMMAND_QUEUE_SIZE = 48
+MIN_COMMAND_QUEUE_SIZE = 40
+MAX_COMMAND_QUEUE_SIZE = 255
+
 CONF_PERIOD = "period"
 
+# Telemetry streams and the ``TelemetryChannel`` bits they cover.
+TELEMETRY_STREAMS = {
+    "power": 0x001,
+    "voltage": 0x00E,
+    "current": 0x070,
+    "temperature": 0x180,
+}
+# The C++ log hands out 64 byte blocks and needs a few per channel.
+MIN_TELEMETRY_BUFFER_SIZE = 1024
+MAX_TELEMETRY_BUFFER_SIZE = 65536
+
+# Subscription broker owners are namespaced so YAML entities and the
+# ``esp32evse.<name>.subscribe`` actions never share a request.
+ENTITY_OWNER_PREFIX = "entity:"
+ACTION_OWNER_PREFIX = "action:"
+
 _REGISTERED_COMPONENT_IDS = []
+# Queue sizes requested by every configured instance.  The C++ capacity is a
+# single compile-time constant, so code generation uses the largest one.
+_COMMAND_QUEUE_SIZES = []
 
 
 def _normalize_subscription_period(value):
@@ -89,6 +188,210 @@ def _normalize_subscription_period(value):
     return period
 
 
+def poll_interval(value):
+    """Accept ``once``, ``always`` or a time period for an entity poll interval."""
+
+    if isinstance(value, str):
+        keyword = value.strip().lower()
+        if keyword == "once":
+            return POLL_ONCE
+        if keyword == "always":
+            return POLL_EVERY_UPDATE
+    period = cv.positive_time_period_milliseconds(value)
+    total_ms = period.total_milliseconds
+    if total_ms >= POLL_ONCE:
+        raise cv.Invalid("poll_interval is too long; use 'once' to poll once per EVSE boot")
+    return total_ms
+
+
+def entity_subscription_period(value):
+    """Validate the push period of an entity ``subscribe`` option."""
+
+    period = cv.positive_time_period_milliseconds(value)
+    if period.total_milliseconds < MIN_SUBSCRIPTION_PERIOD_MS:
+        raise cv.Invalid("subscribe period must be at least 100ms")
+    return period.total_milliseconds
+
+
+# Entity schemas extend this so every entity may override how often the AT
+# query backing it is sent, or have the EVSE push it instead.
+QUERY_OPTIONS_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_POLL_INTERVAL): poll_interval,
+        cv.Optional(CONF_SUBSCRIBE): entity_subscription_period,
+    }
+)
+
+
+def register_query_options(parent, config, targets):
+    """Poll the slots of configured entities and forward their query options.
+
+    ``targets`` maps an entity key of the platform schema to the name of the
+    ``FreshnessSlot`` that backs it and the ``AT+SUB`` target that pushes it.
+    Each slot is registered once with ``require_slot`` so the C++ side only
+    queries what this configuration uses.  Subscriptions are owned by
+    ``entity:<key>``, so an action on the same value cannot withdraw them.
+    """
+
+    required = set()
+    for key, (slot, target) in targets.items():
+        entity_config = config.get(key)
+        if entity_config is None:
+            continue
+        if slot not in required:
+            required.add(slot)
+            cg.add(parent.require_slot(getattr(FreshnessSlot, slot)))
+        if CONF_POLL_INTERVAL in entity_config:
+            cg.add(
+                parent.set_poll_interval(
+                    getattr(FreshnessSlot, slot), entity_config[CONF_POLL_INTERVAL]
+                )
+            )
+        if CONF_SUBSCRIBE in entity_config:
+            cg.add(
+                parent.request_subscription(
+                    target, f"{ENTITY_OWNER_PREFIX}{key}", entity_config[CONF_SUBSCRIBE]
+                )
+            )
+
+
+def register_entity(parent, entity_id, entity):
+    """Attach ``entity`` to the registry of ``parent`` as ``EntityId.<entity_id>``."""
+
+    cg.add(parent.register_entity(getattr(EntityId, entity_id), entity))
+
+
+def _publish_delta(value):
+    """Accept an absolute deadband (``0.5``) or a relative one (``2%``)."""
+
+    if isinstance(value, str) and value.strip().endswith("%"):
+        percent = cv.positive_float(value.strip()[:-1])
+        return (percent / 100.0, True)
+    return (cv.positive_float(value), False)
+
+
+# Entities fed at subscription rates can drop uninteresting values before they
+# reach ``publish_state`` and the ESPHome filter chain.
+PUBLISH_FILTER_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_PUBLISH_FILTER): cv.Schema(
+            {
+                cv.Optional(CONF_ONLY_ON_CHANGE, default=True): cv.boolean,
+                cv.Optional(CONF_DELTA, default=0.0): _publish_delta,
+                cv.Optional(
+                    CONF_MIN_INTERVAL, default="0ms"
+                ): cv.positive_time_period_milliseconds,
+            }
+        )
+    }
+)
+
+
+async def register_publish_filters(parent, config, keys):
+    """Configure the publish filter of every entity in ``keys`` that has one."""
+
+    for key in keys:
+        entity_config = config.get(key)
+        if entity_config is None or CONF_PUBLISH_FILTER not in entity_config:
+            continue
+        filter_config = entity_config[CONF_PUBLISH_FILTER]
+        entity = await cg.get_variable(entity_config[CONF_ID])
+        delta, relative = filter_config[CONF_DELTA]
+        cg.add(
+            parent.set_publish_filter(
+                entity,
+                delta,
+                relative,
+                filter_config[CONF_MIN_INTERVAL].total_milliseconds,
+                filter_config[CONF_ONLY_ON_CHANGE],
+            )
+        )
+
+
+# Switches and numbers that publish a write right away and roll it back if the
+# EVSE refuses it, see ``ESP32EVSEOptimisticEntity``.
+OPTIMISTIC_SCHEMA = cv.Schema({cv.Optional(CONF_OPTIMISTIC, default=False): cv.boolean})
+
+
+async def register_optimistic(config, keys):
+    """Mark every entity in ``keys`` that asks for it as optimistic."""
+
+    for key in keys:
+        entity_config = config.get(key)
+        if entity_config is None or not entity_config[CONF_OPTIMISTIC]:
+            continue
+        entity = await cg.get_variable(entity_config[CONF_ID])
+        cg.add(entity.set_optimistic(True))
+
+
+def _telemetry_channel_mask(streams):
+    mask = 0
+    for stream in streams:
+        mask |= TELEMETRY_STREAMS[stream]
+    return mask
+
+
+# Fixed-RAM time-series of the power, voltage, current and temperature streams.
+TELEMETRY_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_BUFFER_SIZE, default=8192): cv.int_range(
+            min=MIN_TELEMETRY_BUFFER_SIZE, max=MAX_TELEMETRY_BUFFER_SIZE
+        ),
+        cv.Optional(CONF_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_STREAMS, default=list(TELEMETRY_STREAMS)): cv.All(
+            cv.ensure_list(cv.one_of(*TELEMETRY_STREAMS, lower=True)), cv.Length(min=1)
+        ),
+    }
+)
+
+
+def _validate_load_management(config):
+    if config[CONF_FAILSAFE_CURRENT] > config[CONF_FUSE_LIMIT]:
+        raise cv.Invalid("failsafe_current may not exceed fuse_limit")
+    return config
+
+
+# Cache the last known state in flash and republish it at boot.  Snapshots are
+# only written when something changed, at most once per ``save_interval``.
+WARM_START_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_SAVE_INTERVAL, default="15min"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(minutes=1)),
+        ),
+    }
+)
+
+
+_GRID_CURRENT_KEYS = (CONF_GRID_CURRENT_L1, CONF_GRID_CURRENT_L2, CONF_GRID_CURRENT_L3)
+
+# Native dynamic load management, see ``set_load_management`` in C++.  Only the
+# phases the charger is wired to should be listed.
+LOAD_MANAGEMENT_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_GRID_CURRENT_L1): cv.use_id(sensor.Sensor),
+            cv.Optional(CONF_GRID_CURRENT_L2): cv.use_id(sensor.Sensor),
+            cv.Optional(CONF_GRID_CURRENT_L3): cv.use_id(sensor.Sensor),
+            cv.Required(CONF_FUSE_LIMIT): cv.All(cv.current, cv.Range(min=6.0, max=250.0)),
+            cv.Optional(CONF_HYSTERESIS, default="1A"): cv.All(
+                cv.current, cv.Range(min=0.1, max=10.0)
+            ),
+            # Also the time the meters get to agree after a change.
+            cv.Optional(
+                CONF_MIN_CHANGE_INTERVAL, default="10s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_TIMEOUT, default="10s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_FAILSAFE_CURRENT, default="6A"): cv.All(
+                cv.current, cv.Range(min=6.0, max=63.0)
+            ),
+        }
+    ),
+    cv.has_at_least_one_key(*_GRID_CURRENT_KEYS),
+    _validate_load_management,
+)
+
+
 def _resolve_parent_id(config):
     component_id = config.get(CONF_ESP32EVSE_ID)
     if component_id is not None:
@@ -131,6 +434,7 @@ def _register_component_config(config):
     component_id = config[CONF_ID]
     if component_id not in _REGISTERED_COMPONENT_IDS:
         _REGISTERED_COMPONENT_IDS.append(component_id)
+    _COMMAND_QUEUE_SIZES.append(config[CONF_COMMAND_QUEUE_SIZE])
     return config
 
 
@@ -143,6 +447,40 @@ CONFIG_SCHEMA = cv.All(
         {
             cv.GenerateID(): cv.declare_id(ESP32EVSEComponent),
             cv.Optional(CONF_ON_READY): automation.validate_automation(single=True),
+            # Fires once the startup queries delivered the charger state.
+            cv.Optional(CONF_ON_STATE_READY): automation.validate_automation(
+                single=True
+            ),
+            # Fire per ``+ERROR`` bit that turns on or off; ``bit`` is its index.
+            cv.Optional(CONF_ON_FAULT_RAISED): automation.validate_automation(
+                single=True
+            ),
+            cv.Optional(CONF_ON_FAULT_CLEARED): automation.validate_automation(
+                single=True
+            ),
+            # Fire for every finished switch or number write with its
+            # ``command`` and ``latency_ms`` from queueing to the reply.
+            cv.Optional(CONF_ON_WRITE_SUCCESS): automation.validate_automation(
+                single=True
+            ),
+            cv.Optional(CONF_ON_WRITE_FAILED): automation.validate_automation(
+                single=True
+            ),
+            # Compile in per-response parser timing that is logged on every
+            # poll.  Off by default so production builds pay nothing for it.
+            cv.Optional(CONF_PARSER_STATS, default=False): cv.boolean,
+            # Number of AT commands that may wait for the UART at once.  Each
+            # slot costs roughly 100 bytes of RAM.
+            cv.Optional(
+                CONF_COMMAND_QUEUE_SIZE, default=DEFAULT_COMMAND_QUEUE_SIZE
+            ): cv.int_range(min=MIN_COMMAND_QUEUE_SIZE, max=MAX_COMMAND_QUEUE_SIZE),
+            # How many AT commands may be outstanding before their OK/ERROR
+            # arrives.  The EVSE answers in order, so ACKs are matched FIFO.
+            cv.Optional(CONF_COMMAND_WINDOW, default=1): cv.int_range(min=1, max=8),
+            # Keep recent samples on the device itself, see ``TelemetryLog``.
+            cv.Optional(CONF_TELEMETRY): TELEMETRY_SCHEMA,
+            cv.Optional(CONF_LOAD_MANAGEMENT): LOAD_MANAGEMENT_SCHEMA,
+            cv.Optional(CONF_WARM_START): WARM_START_SCHEMA,
         }
     )
     .extend(uart.UART_DEVICE_SCHEMA)
@@ -153,11 +491,34 @@ CONFIG_SCHEMA = cv.All(
 
 # Perform a final check after parsing so the build fails fast if the user
 # forgot to wire the UART RX/TX pins—communication would not work otherwise.
-FINAL_VALIDATE_SCHEMA = uart.final_validate_device_schema(
+_FINAL_VALIDATE_UART = uart.final_validate_device_schema(
     "esp32evse", require_tx=True, require_rx=True
 )
 
 
+def _final_validate(config):
+    _FINAL_VALIDATE_UART(config)
+    if CONF_LOAD_MANAGEMENT not in config:
+        return config
+    # Load management writes through the ``charging_current`` number entity.
+    for item in fv.full_config.get().get("number", []):
+        parent = item.get(CONF_ESP32EVSE_ID)
+        if (
+            item.get("platform") == "esp32evse"
+            and "charging_current" in item
+            and parent is not None
+            and parent.id == config[CONF_ID].id
+        ):
+            return config
+    raise cv.Invalid(
+        "load_management needs a charging_current number for this charger",
+        path=[CONF_LOAD_MANAGEMENT],
+    )
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     """Translate the validated YAML configuration into C++ code.
 
@@ -179,6 +540,74 @@ async def to_code(config):
 
     if CONF_ON_READY in config:
         await automation.build_automation(var.get_ready_trigger(), [], config[CONF_ON_READY])
+    if CONF_ON_STATE_READY in config:
+        await automation.build_automation(
+            var.get_state_ready_trigger(), [], config[CONF_ON_STATE_READY]
+        )
+    if CONF_ON_FAULT_RAISED in config:
+        await automation.build_automation(
+            var.get_fault_raised_trigger(), [(cg.uint8, "bit")], config[CONF_ON_FAULT_RAISED]
+        )
+    if CONF_ON_FAULT_CLEARED in config:
+        await automation.build_automation(
+            var.get_fault_cleared_trigger(), [(cg.uint8, "bit")], config[CONF_ON_FAULT_CLEARED]
+        )
+    for key, trigger in (
+        (CONF_ON_WRITE_SUCCESS, var.get_write_success_trigger()),
+        (CONF_ON_WRITE_FAILED, var.get_write_failed_trigger()),
+    ):
+        if key in config:
+            await automation.build_automation(
+                trigger, [(cg.std_string, "command"), (cg.uint32, "latency_ms")], config[key]
+            )
+    if CONF_ON_FAULT_RAISED in config or CONF_ON_FAULT_CLEARED in config:
+        # The triggers need ``+ERROR`` even without any fault entity.
+        cg.add(var.require_slot(FreshnessSlot.ERROR_FLAGS))
+
+    if config[CONF_PARSER_STATS]:
+        cg.add_define("USE_ESP32EVSE_PARSER_STATS")
+    cg.add_define("ESP32EVSE_COMMAND_QUEUE_SIZE", max(_COMMAND_QUEUE_SIZES))
+    cg.add(var.set_command_window(config[CONF_COMMAND_WINDOW]))
+    if CONF_TELEMETRY in config:
+        telemetry = config[CONF_TELEMETRY]
+        cg.add_define("USE_ESP32EVSE_TELEMETRY")
+        cg.add(
+            var.set_telemetry(
+                telemetry[CONF_BUFFER_SIZE],
+                telemetry[CONF_INTERVAL].total_milliseconds,
+                _telemetry_channel_mask(telemetry[CONF_STREAMS]),
+            )
+        )
+    if CONF_LOAD_MANAGEMENT in config:
+        load_management = config[CONF_LOAD_MANAGEMENT]
+        cg.add_define("USE_ESP32EVSE_LOAD_MANAGEMENT")
+        for phase, key in enumerate(_GRID_CURRENT_KEYS):
+            if key in load_management:
+                grid_sensor = await cg.get_variable(load_management[key])
+                cg.add(var.set_grid_current_sensor(phase, grid_sensor))
+        cg.add(
+            var.set_load_management(
+                load_management[CONF_FUSE_LIMIT],
+                load_management[CONF_HYSTERESIS],
+                load_management[CONF_MIN_CHANGE_INTERVAL].total_milliseconds,
+                load_management[CONF_TIMEOUT].total_milliseconds,
+                load_management[CONF_FAILSAFE_CURRENT],
+            )
+        )
+    if CONF_WARM_START in config:
+        cg.add_define("USE_ESP32EVSE_WARM_START")
+        # The firmware fingerprint is read at every boot, with or without
+        # the version and build time text sensors.
+        cg.add(var.require_slot(FreshnessSlot.VERSION))
+        cg.add(var.require_slot(FreshnessSlot.BUILD_TIME))
+        # The component ID keys the preference, so several chargers on one
+        # node keep separate snapshots.
+        cg.add(
+            var.set_warm_start(
+                config[CONF_WARM_START][CONF_SAVE_INTERVAL].total_milliseconds,
+                str(config[CONF_ID].id),
+            )
+        )
 
 
 _SUBSCRIPTION_TARGETS = {
@@ -252,6 +681,7 @@ def _register_subscription_action(name: str, command: str) -> None:
         var = cg.new_Pvariable(action_id, template_arg)
         await cg.register_parented(var, component_id)
         cg.add(var.set_command(_command))
+        cg.add(var.set_owner(f"{ACTION_OWNER_PREFIX}{name}"))
         period_config = config[CONF_PERIOD]
         if isinstance(period_config, str):
             period_config = 0
@@ -293,3 +723,145 @@ async def force_update_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, component_id)
     return var
+
+
+# ``esp32evse.write`` keys and what they write.  The switches take a boolean,
+# the others a number.
+_WRITE_SWITCH_TARGETS = {
+    "enable": WriteTarget.ENABLE,
+    "available": WriteTarget.AVAILABLE,
+    "request_authorization": WriteTarget.REQUEST_AUTHORIZATION,
+    "emeter_three_phase": WriteTarget.EMETER_THREE_PHASE,
+}
+CONF_CHARGING_CURRENT = "charging_current"
+
+
+def _validate_write(config):
+    targets = [
+        key for key in (*_WRITE_SWITCH_TARGETS, CONF_CHARGING_CURRENT, CONF_NUMBER) if key in config
+    ]
+    if len(targets) != 1:
+        raise cv.Invalid(
+            "Exactly one of "
+            + ", ".join((*_WRITE_SWITCH_TARGETS, CONF_CHARGING_CURRENT, CONF_NUMBER))
+            + " must be given"
+        )
+    if (CONF_NUMBER in config) != (CONF_VALUE in config):
+        raise cv.Invalid("number and value must be given together")
+    return config
+
+
+_WRITE_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_ESP32EVSE_ID): cv.use_id(ESP32EVSEComponent),
+            **{
+                cv.Optional(key): cv.templatable(cv.boolean)
+                for key in _WRITE_SWITCH_TARGETS
+            },
+            cv.Optional(CONF_CHARGING_CURRENT): cv.templatable(cv.current),
+            cv.Optional(CONF_NUMBER): cv.use_id(ESP32EVSEChargingCurrentNumber),
+            cv.Optional(CONF_VALUE): cv.templatable(cv.float_),
+        }
+    ),
+    _validate_write,
+)
+
+
+# Waits for the EVSE's acknowledgement, so the next action runs as soon as the
+# write has landed instead of after a fixed delay.
+@automation.register_action("esp32evse.write", ESP32EVSEWriteAction, _WRITE_SCHEMA)
+async def write_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    if CONF_NUMBER in config:
+        # Number writes go to the number's own charger.
+        cg.add(var.set_target(WriteTarget.NUMBER))
+        cg.add(var.set_number(await cg.get_variable(config[CONF_NUMBER])))
+        cg.add(var.set_value(await cg.templatable(config[CONF_VALUE], args, cg.float_)))
+        return var
+    await cg.register_parented(var, _resolve_parent_id(config))
+    if CONF_CHARGING_CURRENT in config:
+        cg.add(var.set_target(WriteTarget.CHARGING_CURRENT))
+        value = await cg.templatable(config[CONF_CHARGING_CURRENT], args, cg.float_)
+        cg.add(var.set_value(value))
+        return var
+    for key, target in _WRITE_SWITCH_TARGETS.items():
+        if key in config:
+            cg.add(var.set_target(target))
+            cg.add(var.set_state(await cg.templatable(config[key], args, bool)))
+    return var
+
+
+# Mirrors ``CommandString::MAX_LENGTH``; longer commands are refused.
+MAX_COMMAND_LENGTH = 80
+
+
+def _at_command(value):
+    value = cv.string_strict(value)
+    if not value.startswith("AT"):
+        raise cv.Invalid("Commands must start with 'AT'")
+    if "\r" in value or "\n" in value:
+        raise cv.Invalid("Commands must be a single line")
+    if len(value) > MAX_COMMAND_LENGTH:
+        raise cv.Invalid(f"Commands are limited to {MAX_COMMAND_LENGTH} characters")
+    return value
+
+
+_SEND_COMMAND_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_ESP32EVSE_ID): cv.use_id(ESP32EVSEComponent),
+        cv.Required(CONF_COMMAND): cv.templatable(_at_command),
+        cv.Optional(CONF_ON_RESPONSE): automation.validate_automation({}),
+    }
+)
+
+
+# Queued behind the component's own commands and held until the EVSE answers.
+@automation.register_action(
+    "esp32evse.send_command", ESP32EVSESendCommandAction, _SEND_COMMAND_SCHEMA
+)
+async def send_command_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, _resolve_parent_id(config))
+    cg.add(var.set_command(await cg.templatable(config[CONF_COMMAND], args, cg.std_string)))
+    for conf in config.get(CONF_ON_RESPONSE, []):
+        await automation.build_automation(
+            var.get_response_trigger(),
+            [(bool, "success"), (cg.std_vector.template(cg.std_string), "lines")],
+            conf,
+        )
+    return var
+
+
+_TELEMETRY_DUMP_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_ESP32EVSE_ID): cv.use_id(ESP32EVSEComponent),
+        cv.Optional(CONF_WINDOW, default="1h"): cv.templatable(
+            cv.positive_time_period_milliseconds
+        ),
+        cv.Optional(CONF_STREAMS): cv.ensure_list(
+            cv.one_of(*TELEMETRY_STREAMS, lower=True)
+        ),
+    }
+)
+
+
+@automation.register_action(
+    "esp32evse.telemetry_dump",
+    ESP32EVSETelemetryDumpAction,
+    _TELEMETRY_DUMP_SCHEMA,
+    synchronous=True,
+)
+async def telemetry_dump_to_code(config, action_id, template_arg, args):
+    component_id = _resolve_parent_id(config)
+    # The action needs the log compiled in; instances without a ``telemetry``
+    # block just report that nothing is recorded.
+    cg.add_define("USE_ESP32EVSE_TELEMETRY")
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, component_id)
+    window = config[CONF_WINDOW]
+    if isinstance(window, cv.TimePeriod):
+        window = window.total_milliseconds
+    cg.add(var.set_window(await cg.templatable(window, args, cg.uint32)))
+    cg.add(var.set_channel_mask(_telemetry_channel_mask(config.get(CONF_STREAMS, []))))
+    return var
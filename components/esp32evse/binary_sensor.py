@@ -19,7 +19,14 @@ from esphome.const import (
     CONF_PUBLISH_INITIAL_STATE,
 )
 
-from . import CONF_ESP32EVSE_ID, ESP32EVSEComponent, esp32evse_ns
+from . import (
+    CONF_ESP32EVSE_ID,
+    QUERY_OPTIONS_SCHEMA,
+    ESP32EVSEComponent,
+    esp32evse_ns,
+    register_entity,
+    register_query_options,
+)
 
 DEPENDENCIES = ["esp32evse"]
 
@@ -61,6 +68,9 @@ ESP32EVSETemperatureFaultBinarySensor = esp32evse_ns.class_(
 ESP32EVSETimeoutFaultBinarySensor = esp32evse_ns.class_(
     "ESP32EVSETimeoutFaultBinarySensor", binary_sensor.BinarySensor
 )
+ESP32EVSEStaleDataBinarySensor = esp32evse_ns.class_(
+    "ESP32EVSEStaleDataBinarySensor", binary_sensor.BinarySensor
+)
 
 CONF_PENDING_AUTHORIZATION = "pending_authorization"
 CONF_WIFI_CONNECTED = "wifi_connected"
@@ -74,6 +84,24 @@ CONF_RCM_SELF_TEST_FAULT = "rcm_self_test_fault"
 CONF_TEMPERATURE_HIGH_FAULT = "temperature_high_fault"
 CONF_TEMPERATURE_FAULT = "temperature_sensor_fault"
 CONF_TIMEOUT_FAULT = "timeout_fault"
+CONF_STALE_DATA = "stale_data"
+
+# Freshness slot and ``AT+SUB`` target backing each binary sensor.  The fault
+# flags all come from ``+ERROR``; the timeout fault and the stale-data flag are
+# raised locally and never polled.
+_QUERY_TARGETS = {
+    CONF_PENDING_AUTHORIZATION: ("PENDING_AUTHORIZATION", '"+PENDAUTH"'),
+    CONF_WIFI_CONNECTED: ("WIFI_STATUS", '"+WIFISTACONN"'),
+    CONF_CHARGING_LIMIT_REACHED: ("CHARGING_LIMIT_REACHED", '"+LIMREACH"'),
+    CONF_PILOT_FAULT: ("ERROR_FLAGS", '"+ERROR"'),
+    CONF_DIODE_SHORT: ("ERROR_FLAGS", '"+ERROR"'),
+    CONF_LOCK_FAULT: ("ERROR_FLAGS", '"+ERROR"'),
+    CONF_UNLOCK_FAULT: ("ERROR_FLAGS", '"+ERROR"'),
+    CONF_RCM_TRIGGERED: ("ERROR_FLAGS", '"+ERROR"'),
+    CONF_RCM_SELF_TEST_FAULT: ("ERROR_FLAGS", '"+ERROR"'),
+    CONF_TEMPERATURE_HIGH_FAULT: ("ERROR_FLAGS", '"+ERROR"'),
+    CONF_TEMPERATURE_FAULT: ("ERROR_FLAGS", '"+ERROR"'),
+}
 
 
 def _with_default_trigger(config: dict) -> dict:
@@ -95,7 +123,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_PENDING_AUTHORIZATION): binary_sensor.binary_sensor_schema(
                 ESP32EVSEPendingAuthorizationBinarySensor,
                 icon="mdi:hand-extended",
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             # Report the Wi-Fi connectivity status of the charger to aid in
             # diagnostics when connectivity issues arise.
             cv.Optional(CONF_WIFI_CONNECTED): binary_sensor.binary_sensor_schema(
@@ -103,58 +131,65 @@ CONFIG_SCHEMA = cv.All(
                 device_class=DEVICE_CLASS_CONNECTIVITY,
                 icon="mdi:check-network-outline",
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             # Indicate when the EVSE has finished supplying the energy corresponding 
             # to the configured charging limit.
             cv.Optional(CONF_CHARGING_LIMIT_REACHED): binary_sensor.binary_sensor_schema(
                 ESP32EVSEChargingLimitReachedBinarySensor,
                 icon="mdi:battery-check-outline",
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_PILOT_FAULT): binary_sensor.binary_sensor_schema(
                 ESP32EVSEPilotFaultBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_DIODE_SHORT): binary_sensor.binary_sensor_schema(
                 ESP32EVSEDiodeShortBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_LOCK_FAULT): binary_sensor.binary_sensor_schema(
                 ESP32EVSELockFaultBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_UNLOCK_FAULT): binary_sensor.binary_sensor_schema(
                 ESP32EVSEUnlockFaultBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_RCM_TRIGGERED): binary_sensor.binary_sensor_schema(
                 ESP32EVSERCMTriggeredBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_RCM_SELF_TEST_FAULT): binary_sensor.binary_sensor_schema(
                 ESP32EVSERCMSelfTestFaultBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_TEMPERATURE_HIGH_FAULT): binary_sensor.binary_sensor_schema(
                 ESP32EVSETemperatureHighFaultBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_TEMPERATURE_FAULT): binary_sensor.binary_sensor_schema(
                 ESP32EVSETemperatureFaultBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_TIMEOUT_FAULT): binary_sensor.binary_sensor_schema(
                 ESP32EVSETimeoutFaultBinarySensor,
                 device_class=DEVICE_CLASS_PROBLEM,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
             ),
+            # On while the published states are still the cached warm-start
+            # values and the EVSE has not confirmed them yet.
+            cv.Optional(CONF_STALE_DATA): binary_sensor.binary_sensor_schema(
+                ESP32EVSEStaleDataBinarySensor,
+                icon="mdi:history",
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
         }
     ),
     # Require that at least one sensor is configured to avoid creating empty
@@ -172,53 +207,42 @@ CONFIG_SCHEMA = cv.All(
         CONF_TEMPERATURE_HIGH_FAULT,
         CONF_TEMPERATURE_FAULT,
         CONF_TIMEOUT_FAULT,
+        CONF_STALE_DATA,
     ),
 )
 
+# ``EntityId`` of each binary sensor.
+_BINARY_SENSOR_ENTITIES = {
+    # Set whenever the EVSE expects a user action, such as tapping an RFID card.
+    CONF_PENDING_AUTHORIZATION: "PENDING_AUTHORIZATION",
+    # Lets operators see the charger fall offline without opening its web UI.
+    CONF_WIFI_CONNECTED: "WIFI_CONNECTED",
+    # The EVSE stopped charging because a time, energy or under-power limit
+    # was reached.
+    CONF_CHARGING_LIMIT_REACHED: "CHARGING_LIMIT_REACHED",
+    CONF_PILOT_FAULT: "PILOT_FAULT",
+    CONF_DIODE_SHORT: "DIODE_SHORT",
+    CONF_LOCK_FAULT: "LOCK_FAULT",
+    CONF_UNLOCK_FAULT: "UNLOCK_FAULT",
+    CONF_RCM_TRIGGERED: "RCM_TRIGGERED",
+    CONF_RCM_SELF_TEST_FAULT: "RCM_SELF_TEST_FAULT",
+    CONF_TEMPERATURE_HIGH_FAULT: "TEMPERATURE_HIGH_FAULT",
+    CONF_TEMPERATURE_FAULT: "TEMPERATURE_FAULT",
+    CONF_TIMEOUT_FAULT: "TIMEOUT_FAULT",
+    CONF_STALE_DATA: "STALE_DATA",
+}
+
 
 async def to_code(config):
     """Create the configured binary sensors and attach them to the component."""
 
     parent = await cg.get_variable(config[CONF_ESP32EVSE_ID])
+    register_query_options(parent, config, _QUERY_TARGETS)
 
-    if pending_config := config.get(CONF_PENDING_AUTHORIZATION):
-        # The pending-authorization flag is updated whenever the EVSE expects a
-        # user action (such as tapping an RFID card), so we forward its state.
-        sens = await binary_sensor.new_binary_sensor(
-            _with_default_trigger(pending_config)
-        )
-        await cg.register_parented(sens, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_pending_authorization_binary_sensor(sens))
-    if wifi_config := config.get(CONF_WIFI_CONNECTED):
-        # Track Wi-Fi connectivity so operators can detect when the charger
-        # falls offline without looking at the controller's web UI.
-        sens = await binary_sensor.new_binary_sensor(
-            _with_default_trigger(wifi_config)
-        )
-        await cg.register_parented(sens, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_wifi_connected_binary_sensor(sens))
-    if limit_config := config.get(CONF_CHARGING_LIMIT_REACHED):
-        # Surface the flag that signals when the EVSE stopped charging because a
-        # configured limit (time/energy/under-power) has been reached.
-        sens = await binary_sensor.new_binary_sensor(
-            _with_default_trigger(limit_config)
-        )
-        await cg.register_parented(sens, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_charging_limit_reached_binary_sensor(sens))
-    for key, setter in (
-        (CONF_PILOT_FAULT, parent.set_pilot_fault_binary_sensor),
-        (CONF_DIODE_SHORT, parent.set_diode_short_binary_sensor),
-        (CONF_LOCK_FAULT, parent.set_lock_fault_binary_sensor),
-        (CONF_UNLOCK_FAULT, parent.set_unlock_fault_binary_sensor),
-        (CONF_RCM_TRIGGERED, parent.set_rcm_triggered_binary_sensor),
-        (CONF_RCM_SELF_TEST_FAULT, parent.set_rcm_self_test_fault_binary_sensor),
-        (CONF_TEMPERATURE_HIGH_FAULT, parent.set_temperature_high_fault_binary_sensor),
-        (CONF_TEMPERATURE_FAULT, parent.set_temperature_fault_binary_sensor),
-        (CONF_TIMEOUT_FAULT, parent.set_timeout_fault_binary_sensor),
-    ):
+    for key, entity_id in _BINARY_SENSOR_ENTITIES.items():
         if sensor_config := config.get(key):
             sens = await binary_sensor.new_binary_sensor(
                 _with_default_trigger(sensor_config)
             )
             await cg.register_parented(sens, config[CONF_ESP32EVSE_ID])
-            cg.add(setter(sens))
+            register_entity(parent, entity_id, sens)
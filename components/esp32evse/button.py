@@ -64,20 +64,15 @@ CONFIG_SCHEMA = cv.All(
 async def to_code(config):
     """Create the configured buttons and link them to the EVSE component."""
 
-    parent = await cg.get_variable(config[CONF_ESP32EVSE_ID])
-
     if reset_config := config.get(CONF_RESET):
         # The reset button sends the ``AT+RESET`` command via UART when pressed.
         btn = await button.new_button(reset_config)
         await cg.register_parented(btn, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_reset_button(btn))
     if authorize_config := config.get(CONF_AUTHORIZE):
         # The authorize button requests the EVSE to begin charging the session.
         btn = await button.new_button(authorize_config)
         await cg.register_parented(btn, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_authorize_button(btn))
     if start_ap_config := config.get(CONF_START_AP):
         # Enable the EVSE's access point mode via AT command.
         btn = await button.new_button(start_ap_config)
         await cg.register_parented(btn, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_start_ap_button(btn))
@@ -3,6 +3,7 @@
 // entities configured in YAML.
 #include "esp32evse.h"
 
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
@@ -11,7 +12,6 @@
 #include <cctype>
 #include <cmath>
 #include <cstdio>
-#include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <inttypes.h>
@@ -30,22 +30,206 @@ namespace {
 constexpr uint32_t kDefaultUpdateIntervalMs = 60'000;
 constexpr uint32_t kMinUpdateIntervalMs = 10'000;
 constexpr uint32_t kMaxUpdateIntervalMs = 600'000;
+constexpr uint32_t kSlowPollIntervalMs = 600'000;
+// Command timeouts follow the measured round trips but stay within these
+// bounds; the upper one is also used until enough samples exist and for the
+// probes sent while the link is down.  The floor keeps ordinary latency spikes
+// from timing out; a reply that does arrive late is dropped by the probe that
+// follows every timeout rather than matched to the next command.
+constexpr uint32_t kMinCommandTimeoutMs = 750;
+constexpr uint32_t kMaxCommandTimeoutMs = 5000;
+constexpr uint32_t kCommandTimeoutFactor = 4;
+constexpr size_t kMinRttSamples = 8;
+// Consecutive timeouts that take the link down, and the probe backoff range.
+constexpr uint8_t kLinkDownAfterTimeouts = 3;
+constexpr uint32_t kMinProbeIntervalMs = 1000;
+constexpr uint32_t kMaxProbeIntervalMs = 60'000;
+// Probe queries.  Their ``+`` lines mark where the abandoned replies end, so
+// they must not be subscribed; the identity keys never are.  A probe is never
+// one of the commands abandoned during the same resync, whose late replies
+// would otherwise be taken for its own.
+constexpr const char *kProbeCommands[] = {"AT+CHIP?",       "AT+VER?",       "AT+IDFVER?",  "AT+BUILDTIME?",
+                                          "AT+WIFISTAMAC?", "AT+WIFISTACFG?", "AT+DEVNAME?"};
+constexpr uint8_t kAllProbeCommands = (1u << (sizeof(kProbeCommands) / sizeof(kProbeCommands[0]))) - 1;
+// A timeout with several commands in flight may mean a reply was lost, which
+// shifts every later one; the window stays at one command until this many
+// acks in a row arrive in time.
+constexpr uint8_t kSerialAcksAfterTimeout = 32;
 constexpr size_t kRxChunkSize = 64;
-constexpr size_t kMaxLineLength = 512;
-
-// Utility: return a pointer to the substring that follows ``prefix`` if the
-// incoming UART line starts with it.  Many EVSE responses follow a predictable
-// ``KEY=VALUE`` structure, so this helper keeps the parsing code terse.
-const char *value_after_prefix(const std::string &line, const char *prefix) {
-  const size_t prefix_len = strlen(prefix);
-  if (line.compare(0, prefix_len, prefix) != 0)
-    return nullptr;
-  size_t pos = prefix_len;
+// Longest a queued command of each ``CommandPriority`` can be overtaken by more
+// urgent ones.  Sized so a user action beats a forced refresh and background
+// polls still finish well within an update interval.
+constexpr std::array<uint32_t, ESP32EVSEComponent::COMMAND_PRIORITY_COUNT> kPriorityMaxWaitMs{0, 1000, 5000, 15'000};
+// Bytes of ``+`` lines kept for one raw command; the rest is dropped.
+constexpr size_t kMaxRawResponseLength = 1024;
+// Power samples further apart than this are not integrated; the session energy
+// then waits for the next ``+EMETERCONSUM`` instead of guessing across the gap.
+constexpr uint32_t kMaxIntegrationGapMs = 10'000;
+constexpr uint64_t kMillijoulesPerWattHour = 3'600'000;
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+// Load management subtracts the charger's own draw, so it keeps
+// ``+EMETERCURRENT`` streaming at this period.
+constexpr uint32_t kLoadManagementCurrentPeriodMs = 1000;
+// Broker owner of that subscription; ``unsubscribe_all`` leaves it in place.
+constexpr const char *kLoadManagementOwner = "load_management";
+#endif
+#ifdef USE_ESP32EVSE_WARM_START
+// Bump when ``WarmStartSnapshot`` changes so old snapshots are ignored.
+constexpr uint32_t kWarmStartMagic = 0x45565301;
+constexpr uint8_t kFingerprintVersion = 1u << 0;
+constexpr uint8_t kFingerprintBuildTime = 1u << 1;
+
+// Copy ``value`` into a fixed NUL-terminated field, truncating it to fit.
+template<size_t N> void copy_field(char (&field)[N], std::string_view value) {
+  const size_t length = std::min(value.size(), N - 1);
+  std::memcpy(field, value.data(), length);
+  std::memset(field + length, 0, N - length);
+}
+#endif
+
+// Every ``+KEY`` response understood by ``process_line_``.  The enumerator
+// order must match ``kResponseKeyNames`` below.
+enum class ResponseKey : uint8_t {
+  STATE,
+  ENABLE,
+  TEMP,
+  CHCUR,
+  EMETERPOWER,
+  EMETERSESTIME,
+  EMETERCHTIME,
+  UPTIME,
+  CHIP,
+  VER,
+  IDFVER,
+  BUILDTIME,
+  TIME,
+  WIFISTACFG,
+  WIFISTAIP,
+  WIFISTAMAC,
+  DEVNAME,
+  AVAILABLE,
+  REQAUTH,
+  EMETERTHREEPHASE,
+  HEAP,
+  EMETERCONSUM,
+  EMETERTOTCONSUM,
+  EMETERVOLTAGE,
+  EMETERCURRENT,
+  WIFISTACONN,
+  DEFCHCUR,
+  MAXCHCUR,
+  CONSUMLIM,
+  DEFCONSUMLIM,
+  CHTIMELIM,
+  DEFCHTIMELIM,
+  UNDERPOWERLIM,
+  DEFUNDERPOWERLIM,
+  LIMREACH,
+  ERROR,
+  PENDAUTH,
+  UNKNOWN,
+};
+
+constexpr std::array<std::string_view, static_cast<size_t>(ResponseKey::UNKNOWN)> kResponseKeyNames{{
+    "STATE", "ENABLE", "TEMP", "CHCUR", "EMETERPOWER", "EMETERSESTIME", "EMETERCHTIME", "UPTIME",
+    "CHIP", "VER", "IDFVER", "BUILDTIME", "TIME", "WIFISTACFG", "WIFISTAIP", "WIFISTAMAC",
+    "DEVNAME", "AVAILABLE", "REQAUTH", "EMETERTHREEPHASE", "HEAP", "EMETERCONSUM",
+    "EMETERTOTCONSUM", "EMETERVOLTAGE", "EMETERCURRENT", "WIFISTACONN", "DEFCHCUR", "MAXCHCUR",
+    "CONSUMLIM", "DEFCONSUMLIM", "CHTIMELIM", "DEFCHTIMELIM", "UNDERPOWERLIM", "DEFUNDERPOWERLIM",
+    "LIMREACH", "ERROR", "PENDAUTH",
+}};
+static_assert(kResponseKeyNames.size() <= 64, "malformed_keys_warned_ needs a bit per response key");
+
+// Minimal perfect hash over ``kResponseKeyNames``: FNV-1a of the key followed
+// by a multiplicative mix whose top bits index a 128 entry slot table.  The
+// multiplier was chosen so every key lands in its own slot; the static_assert
+// below fails the build if a newly added key collides, in which case pick a
+// different odd multiplier.
+constexpr size_t kResponseKeySlotBits = 7;
+constexpr size_t kResponseKeySlotCount = size_t{1} << kResponseKeySlotBits;
+constexpr uint32_t kResponseKeyMultiplier = 151;
+constexpr uint8_t kEmptyResponseKeySlot = 0xFF;
+
+constexpr size_t response_key_slot(std::string_view key) {
+  uint32_t hash = 2166136261u;
+  for (char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return static_cast<uint32_t>(hash * kResponseKeyMultiplier) >> (32 - kResponseKeySlotBits);
+}
+
+constexpr std::array<uint8_t, kResponseKeySlotCount> build_response_key_slots() {
+  std::array<uint8_t, kResponseKeySlotCount> slots{};
+  for (auto &slot : slots)
+    slot = kEmptyResponseKeySlot;
+  for (size_t i = 0; i < kResponseKeyNames.size(); ++i)
+    slots[response_key_slot(kResponseKeyNames[i])] = static_cast<uint8_t>(i);
+  return slots;
+}
+
+constexpr std::array<uint8_t, kResponseKeySlotCount> kResponseKeySlots = build_response_key_slots();
+
+constexpr bool response_key_slots_are_unique() {
+  for (size_t i = 0; i < kResponseKeyNames.size(); ++i) {
+    if (kResponseKeySlots[response_key_slot(kResponseKeyNames[i])] != i)
+      return false;
+  }
+  return true;
+}
+
+static_assert(response_key_slots_are_unique(), "Response key hash collision; adjust kResponseKeyMultiplier");
+
+// Utility: classify a ``+KEY[=|:] VALUE`` line in O(key length) and point
+// ``value`` at the payload that follows the separator and any whitespace.
+ResponseKey lookup_response_key(std::string_view line, const char **value) {
+  if (line.size() < 2 || line[0] != '+')
+    return ResponseKey::UNKNOWN;
+  size_t pos = 1;
+  while (pos < line.size() && line[pos] != '=' && line[pos] != ':' &&
+         !isspace(static_cast<unsigned char>(line[pos])))
+    ++pos;
+  std::string_view key(line.data() + 1, pos - 1);
+  uint8_t index = kResponseKeySlots[response_key_slot(key)];
+  if (index == kEmptyResponseKeySlot || kResponseKeyNames[index] != key)
+    return ResponseKey::UNKNOWN;
+
   if (pos < line.size() && (line[pos] == '=' || line[pos] == ':'))
     ++pos;
   while (pos < line.size() && isspace(static_cast<unsigned char>(line[pos])))
     ++pos;
-  return line.c_str() + pos;
+  *value = line.data() + pos;
+  return static_cast<ResponseKey>(index);
+}
+
+// Map a subscription argument such as ``"+EMETERPOWER"`` (quotes optional) to
+// its response key.
+ResponseKey lookup_subscription_target(std::string_view target) {
+  if (target.size() >= 2 && target.front() == '"' && target.back() == '"')
+    target = target.substr(1, target.size() - 2);
+  const char *value = nullptr;
+  return lookup_response_key(target, &value);
+}
+
+// Utility: locate the first ``\r`` or ``\n`` in ``data`` using two bounded
+// ``memchr`` scans instead of a per-byte loop.
+char *find_line_end(char *data, size_t length) {
+  char *lf = static_cast<char *>(memchr(data, '\n', length));
+  size_t search = lf != nullptr ? static_cast<size_t>(lf - data) : length;
+  char *cr = static_cast<char *>(memchr(data, '\r', search));
+  return cr != nullptr ? cr : lf;
+}
+
+bool is_query_command(std::string_view command) { return !command.empty() && command.back() == '?'; }
+
+// ``AT+KEY?`` and ``AT+KEY=...`` are answered by ``+KEY: ...`` lines.
+bool answers_command(std::string_view command, std::string_view line) {
+  if (command.size() < 2)
+    return false;
+  std::string_view key = command.substr(2);
+  key = key.substr(0, key.find_first_of("=?"));
+  return !key.empty() && line.size() > key.size() && line.compare(0, key.size(), key) == 0 &&
+         line[key.size()] == ':';
 }
 
 // Utility: trim whitespace and optional quotes from a string returned by the
@@ -66,8 +250,6 @@ std::string_view trim_view(const char *value) {
   return out;
 }
 
-std::string trim_copy(const char *value) { return std::string(trim_view(value)); }
-
 std::string_view nth_trimmed_token(std::string_view input, size_t token_index,
                                    char delimiter = ',') {
   size_t start = 0;
@@ -99,24 +281,267 @@ std::string_view nth_trimmed_token(std::string_view input, size_t token_index,
   return {};
 }
 
-// Utility: parse the last floating point number contained in a response.
-float parse_last_float(const char *input) {
-  if (input == nullptr)
-    return NAN;
-  float result = NAN;
-  const char *start = input;
-  char *endptr = nullptr;
-  while (*start != '\0') {
-    float value = strtof(start, &endptr);
-    if (endptr == start) {
-      ++start;
-      continue;
+// Result of reading one numeric field of a response.
+enum class FieldStatus : uint8_t { OK, MISSING, INVALID, OUT_OF_RANGE };
+
+const char *field_status_str(FieldStatus status) {
+  switch (status) {
+    case FieldStatus::OK:
+      return "ok";
+    case FieldStatus::MISSING:
+      return "missing field";
+    case FieldStatus::INVALID:
+      return "not a number";
+    case FieldStatus::OUT_OF_RANGE:
+      return "out of range";
+  }
+  return "?";
+}
+
+constexpr int64_t kPow10[] = {1, 10, 100, 1'000, 10'000, 100'000, 1'000'000};
+
+// Parse a whole field as an integer.  Accepts a leading ``+`` and, like
+// ``strtoul(..., 0)``, a ``0x`` prefix for hexadecimal.
+template<typename T> FieldStatus parse_integer(std::string_view field, T &out) {
+  if (field.empty())
+    return FieldStatus::MISSING;
+  if (field.front() == '+')
+    field.remove_prefix(1);
+  int base = 10;
+  if (field.size() > 2 && field[0] == '0' && (field[1] == 'x' || field[1] == 'X')) {
+    field.remove_prefix(2);
+    base = 16;
+  }
+  const char *end = field.data() + field.size();
+  auto result = std::from_chars(field.data(), end, out, base);
+  if (result.ec == std::errc::result_out_of_range)
+    return FieldStatus::OUT_OF_RANGE;
+  if (result.ec != std::errc() || result.ptr != end)
+    return FieldStatus::INVALID;
+  return FieldStatus::OK;
+}
+
+// Parse a decimal such as ``-12.345`` into a fixed-point integer with
+// ``decimals`` fractional digits (``230.1`` with 3 decimals is ``230100``).
+// Extra fractional digits are truncated.  No floating point is involved.
+FieldStatus parse_fixed(std::string_view field, uint8_t decimals, int64_t &out) {
+  if (field.empty())
+    return FieldStatus::MISSING;
+  bool negative = false;
+  if (field.front() == '+' || field.front() == '-') {
+    negative = field.front() == '-';
+    field.remove_prefix(1);
+  }
+  const char *cursor = field.data();
+  const char *end = field.data() + field.size();
+  int64_t whole = 0;
+  if (cursor != end && *cursor != '.') {
+    auto result = std::from_chars(cursor, end, whole);
+    if (result.ec == std::errc::result_out_of_range)
+      return FieldStatus::OUT_OF_RANGE;
+    if (result.ec != std::errc())
+      return FieldStatus::INVALID;
+    cursor = result.ptr;
+  }
+  int64_t fraction = 0;
+  uint8_t digits = 0;
+  if (cursor != end && *cursor == '.') {
+    ++cursor;
+    for (; cursor != end && *cursor >= '0' && *cursor <= '9'; ++cursor) {
+      if (digits < decimals) {
+        fraction = fraction * 10 + (*cursor - '0');
+        ++digits;
+      }
+    }
+  }
+  if (cursor != end || cursor == field.data())
+    return FieldStatus::INVALID;
+  const int64_t scale = kPow10[decimals];
+  if (whole > std::numeric_limits<int64_t>::max() / scale)
+    return FieldStatus::OUT_OF_RANGE;
+  int64_t value = whole * scale + fraction * kPow10[decimals - digits];
+  out = negative ? -value : value;
+  return FieldStatus::OK;
+}
+
+// Integer milli-units (mV, mA) to the float a sensor publishes.  Multiplying
+// by the reciprocal stays within one ulp of a divide and is much cheaper on
+// chips without an FPU, where every float operation is a library call.
+float milli_to_float(int64_t milli) { return static_cast<float>(milli) * 0.001f; }
+
+// Names of the ``+ERROR`` bits, indexed by bit number.
+const char *error_flag_name(uint8_t bit) {
+  static const char *const NAMES[] = {"pilot fault",      "diode short",         "lock fault",
+                                      "unlock fault",     "RCM triggered",       "RCM self-test fault",
+                                      "temperature high", "temperature fault"};
+  return bit < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[bit] : "unknown fault";
+}
+
+// True when every entry of a slot-indexed table sits at its slot's index.
+template<typename Entry, size_t N> constexpr bool is_slot_indexed(const Entry (&table)[N]) {
+  for (size_t i = 0; i < N; ++i) {
+    if (static_cast<size_t>(table[i].slot) != i)
+      return false;
+  }
+  return true;
+}
+
+// ``AT+KEY?`` is answered by ``+KEY:`` lines.
+constexpr bool query_answered_by(const char *command, std::string_view key) {
+  if (command[0] != 'A' || command[1] != 'T' || command[2] != '+')
+    return false;
+  for (size_t i = 0; i < key.size(); ++i) {
+    if (command[3 + i] != key[i])
+      return false;
+  }
+  return command[3 + key.size()] == '?';
+}
+
+// Slot answered by each response key, derived from the query strings so
+// replies need no hand-written key to slot mapping.
+constexpr uint8_t kNoResponseSlot = 0xFF;
+template<typename Entry, size_t N>
+constexpr std::array<uint8_t, kResponseKeyNames.size()> build_response_slots(const Entry (&table)[N]) {
+  std::array<uint8_t, kResponseKeyNames.size()> slots{};
+  for (size_t key = 0; key < slots.size(); ++key) {
+    slots[key] = kNoResponseSlot;
+    for (size_t i = 0; i < N; ++i) {
+      if (query_answered_by(table[i].command, kResponseKeyNames[key]))
+        slots[key] = static_cast<uint8_t>(i);
     }
-    result = value;
-    start = endptr;
   }
-  return result;
+  return slots;
+}
+
+// ``EntityId`` lists the entities grouped by kind; the kind follows from the
+// first id of each group.
+using EntityId = ESP32EVSEComponent::EntityId;
+enum class EntityKind : uint8_t { TEXT_SENSOR = 0, SWITCH, SENSOR, NUMBER, BINARY_SENSOR };
+constexpr EntityKind entity_kind(EntityId id) {
+  return id >= EntityId::PENDING_AUTHORIZATION ? EntityKind::BINARY_SENSOR
+         : id >= EntityId::CHARGING_CURRENT    ? EntityKind::NUMBER
+         : id >= EntityId::TEMPERATURE_HIGH    ? EntityKind::SENSOR
+         : id >= EntityId::ENABLE              ? EntityKind::SWITCH
+                                               : EntityKind::TEXT_SENSOR;
+}
+
+#ifdef USE_ESP32EVSE_TELEMETRY
+constexpr uint16_t telemetry_bit(TelemetryChannel channel) {
+  return static_cast<uint16_t>(1u << static_cast<uint8_t>(channel));
+}
+
+struct TelemetryChannelInfo {
+  const char *name;
+  const char *unit;
+  float scale;  // stored integer unit to ``unit``
+  ESP32EVSEComponent::FreshnessSlot slot;  // query that feeds the channel
+};
+
+constexpr TelemetryChannelInfo kTelemetryChannels[TELEMETRY_CHANNEL_COUNT] = {
+    {"power", "W", 1.0f, ESP32EVSEComponent::FreshnessSlot::EMETER_POWER},
+    {"voltage_l1", "V", 0.001f, ESP32EVSEComponent::FreshnessSlot::VOLTAGE},
+    {"voltage_l2", "V", 0.001f, ESP32EVSEComponent::FreshnessSlot::VOLTAGE},
+    {"voltage_l3", "V", 0.001f, ESP32EVSEComponent::FreshnessSlot::VOLTAGE},
+    {"current_l1", "A", 0.001f, ESP32EVSEComponent::FreshnessSlot::CURRENT},
+    {"current_l2", "A", 0.001f, ESP32EVSEComponent::FreshnessSlot::CURRENT},
+    {"current_l3", "A", 0.001f, ESP32EVSEComponent::FreshnessSlot::CURRENT},
+    {"temperature_high", "°C", 0.01f, ESP32EVSEComponent::FreshnessSlot::TEMPERATURE},
+    {"temperature_low", "°C", 0.01f, ESP32EVSEComponent::FreshnessSlot::TEMPERATURE},
+};
+
+// Log lines ``dump_telemetry`` emits per ``loop()`` call; a full buffer holds
+// thousands of samples, far too many to log in one pass.
+constexpr uint16_t kTelemetryDumpLinesPerLoop = 16;
+
+// Signed deltas are zigzag mapped (0, -1, 1, -2, ...) so small magnitudes of
+// either sign become small varints.
+uint32_t zigzag_encode(int32_t value) {
+  return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+int32_t zigzag_decode(uint32_t value) {
+  return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1u);
+}
+
+constexpr size_t kMaxVarintBytes = 5;
+
+// LEB128: seven bits per byte, least significant group first, high bit set on
+// every byte except the last.
+size_t put_varint(uint8_t *out, uint32_t value) {
+  size_t length = 0;
+  while (value >= 0x80) {
+    out[length++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[length++] = static_cast<uint8_t>(value);
+  return length;
+}
+
+bool get_varint(const uint8_t *&cursor, const uint8_t *end, uint32_t &value) {
+  value = 0;
+  for (uint8_t shift = 0; cursor != end && shift < 7 * kMaxVarintBytes; shift += 7) {
+    const uint8_t byte = *cursor++;
+    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
 }
+#endif
+
+// Allocation-free reader for comma separated response values such as
+// ``230100,229800,231000``.  Fields are trimmed of blanks and parsed in place
+// with ``std::from_chars``, so nothing is copied and no locale is consulted.
+class FieldReader {
+ public:
+  explicit FieldReader(std::string_view input) : rest_(input) {}
+
+  // Next field, or ``false`` once the input is exhausted.
+  bool next(std::string_view &field) {
+    if (this->done_)
+      return false;
+    size_t comma = this->rest_.find(',');
+    if (comma == std::string_view::npos) {
+      field = this->rest_;
+      this->done_ = true;
+    } else {
+      field = this->rest_.substr(0, comma);
+      this->rest_.remove_prefix(comma + 1);
+    }
+    while (!field.empty() && isspace(static_cast<unsigned char>(field.front())))
+      field.remove_prefix(1);
+    while (!field.empty() && isspace(static_cast<unsigned char>(field.back())))
+      field.remove_suffix(1);
+    return true;
+  }
+
+  template<typename T> FieldStatus next_integer(T &out) {
+    std::string_view field;
+    if (!this->next(field))
+      return FieldStatus::MISSING;
+    return parse_integer(field, out);
+  }
+
+  FieldStatus next_fixed(uint8_t decimals, int64_t &out) {
+    std::string_view field;
+    if (!this->next(field))
+      return FieldStatus::MISSING;
+    return parse_fixed(field, decimals, out);
+  }
+
+  // Skip to the last field; responses that grew extra leading fields keep
+  // their value at the end.
+  FieldReader &last() {
+    size_t comma = this->rest_.rfind(',');
+    if (!this->done_ && comma != std::string_view::npos)
+      this->rest_.remove_prefix(comma + 1);
+    return *this;
+  }
+
+ private:
+  std::string_view rest_;
+  bool done_{false};
+};
 
 }  // namespace
 
@@ -149,6 +574,10 @@ void ESP32EVSEComponent::CommandString::append(const char *value) {
   this->buffer_[this->length_] = '\0';
 }
 
+bool ESP32EVSEComponent::CommandString::equals(const CommandString &other) const {
+  return this->length_ == other.length_ && memcmp(this->buffer_, other.buffer_, this->length_) == 0;
+}
+
 void ESP32EVSEComponent::CommandString::append_char(char value) {
   if (this->length_ >= MAX_LENGTH)
     return;
@@ -180,23 +609,34 @@ void ESP32EVSEComponent::CommandString::append_unsigned(uint32_t value) {
   this->buffer_[this->length_] = '\0';
 }
 
+ESP32EVSEComponent::PendingCommandQueue::PendingCommandQueue() {
+  for (size_t i = 0; i < CAPACITY; ++i)
+    this->free_slots_[i] = static_cast<uint8_t>(i);
+}
+
 bool ESP32EVSEComponent::PendingCommandQueue::push_back(const PendingCommand &command) {
-  if (this->size_ >= MAX_PENDING_COMMANDS)
-    return false;
-  this->commands_[this->size_] = command;
-  ++this->size_;
-  return true;
+  return this->insert(this->size_, command);
 }
 
 bool ESP32EVSEComponent::PendingCommandQueue::insert(size_t index, const PendingCommand &command) {
-  if (this->size_ >= MAX_PENDING_COMMANDS)
+  if (this->full())
     return false;
   if (index > this->size_)
     index = this->size_;
-  for (size_t i = this->size_; i > index; --i) {
-    this->commands_[i] = this->commands_[i - 1];
+  // Free slots occupy the top of the stack, so the next one sits at ``size_``.
+  uint8_t slot = this->free_slots_[this->size_];
+  this->slots_[slot] = command;
+
+  // Open a gap at ``index`` by moving whichever side of the ring is shorter.
+  if (index < this->size_ - index) {
+    this->head_ = this->head_ == 0 ? CAPACITY - 1 : this->head_ - 1;
+    for (size_t i = 0; i < index; ++i)
+      this->order_[this->position_(i)] = this->order_[this->position_(i + 1)];
+  } else {
+    for (size_t i = this->size_; i > index; --i)
+      this->order_[this->position_(i)] = this->order_[this->position_(i - 1)];
   }
-  this->commands_[index] = command;
+  this->order_[this->position_(index)] = slot;
   ++this->size_;
   return true;
 }
@@ -204,93 +644,204 @@ bool ESP32EVSEComponent::PendingCommandQueue::insert(size_t index, const Pending
 void ESP32EVSEComponent::PendingCommandQueue::pop_front() {
   if (this->size_ == 0)
     return;
-  for (size_t i = 1; i < this->size_; ++i) {
-    this->commands_[i - 1] = this->commands_[i];
-  }
   --this->size_;
-}
+  this->free_slots_[this->size_] = this->order_[this->head_];
+  this->head_ = this->position_(1);
+}
+
+// Query, startup stage, built-in poll interval and reply handling of every
+// slot, in query order.  Identity data only changes with a firmware update
+// (which reboots the EVSE), and the persisted defaults and limits are edited
+// rarely, so neither needs to be refreshed at the ``AT+STATE?`` rate.
+constexpr ESP32EVSEComponent::SlotQuery
+    ESP32EVSEComponent::SLOT_QUERIES[static_cast<size_t>(ESP32EVSEComponent::FreshnessSlot::SLOT_COUNT)] = {
+    {FreshnessSlot::STATE, "AT+STATE?", BootStage::CONTROL, POLL_EVERY_UPDATE, SlotFormat::CUSTOM, EntityId::STATE},
+    {FreshnessSlot::ENABLE, "AT+ENABLE?", BootStage::CONTROL, POLL_EVERY_UPDATE, SlotFormat::FLAG, EntityId::ENABLE},
+    {FreshnessSlot::PENDING_AUTHORIZATION, "AT+PENDAUTH?", BootStage::CONTROL, POLL_EVERY_UPDATE, SlotFormat::FLAG,
+     EntityId::PENDING_AUTHORIZATION},
+    {FreshnessSlot::ERROR_FLAGS, "AT+ERROR?", BootStage::CONTROL, POLL_EVERY_UPDATE, SlotFormat::CUSTOM,
+     EntityId::NONE},
+    {FreshnessSlot::CHARGING_CURRENT, "AT+CHCUR?", BootStage::CONTROL, POLL_EVERY_UPDATE, SlotFormat::CUSTOM,
+     EntityId::CHARGING_CURRENT},
+    {FreshnessSlot::AVAILABLE, "AT+AVAILABLE?", BootStage::CONTROL, POLL_EVERY_UPDATE, SlotFormat::FLAG,
+     EntityId::AVAILABLE},
+    {FreshnessSlot::REQUEST_AUTHORIZATION, "AT+REQAUTH?", BootStage::CONTROL, POLL_EVERY_UPDATE, SlotFormat::FLAG,
+     EntityId::REQUEST_AUTHORIZATION},
+    {FreshnessSlot::EMETER_POWER, "AT+EMETERPOWER?", BootStage::TELEMETRY, POLL_EVERY_UPDATE, SlotFormat::CUSTOM,
+     EntityId::NONE},
+    {FreshnessSlot::VOLTAGE, "AT+EMETERVOLTAGE?", BootStage::TELEMETRY, POLL_EVERY_UPDATE, SlotFormat::CUSTOM,
+     EntityId::NONE},
+    {FreshnessSlot::CURRENT, "AT+EMETERCURRENT?", BootStage::TELEMETRY, POLL_EVERY_UPDATE, SlotFormat::CUSTOM,
+     EntityId::NONE},
+    {FreshnessSlot::TEMPERATURE, "AT+TEMP?", BootStage::TELEMETRY, POLL_EVERY_UPDATE, SlotFormat::CUSTOM,
+     EntityId::NONE},
+    {FreshnessSlot::EMETER_SESSION_TIME, "AT+EMETERSESTIME?", BootStage::TELEMETRY, POLL_EVERY_UPDATE,
+     SlotFormat::INTEGER, EntityId::EMETER_SESSION_TIME},
+    {FreshnessSlot::EMETER_CHARGING_TIME, "AT+EMETERCHTIME?", BootStage::TELEMETRY, POLL_EVERY_UPDATE,
+     SlotFormat::INTEGER, EntityId::EMETER_CHARGING_TIME},
+    {FreshnessSlot::ENERGY_CONSUMPTION, "AT+EMETERCONSUM?", BootStage::TELEMETRY, POLL_EVERY_UPDATE,
+     SlotFormat::CUSTOM, EntityId::NONE},
+    {FreshnessSlot::TOTAL_ENERGY_CONSUMPTION, "AT+EMETERTOTCONSUM?", BootStage::TELEMETRY, POLL_EVERY_UPDATE,
+     SlotFormat::CUSTOM, EntityId::TOTAL_ENERGY_CONSUMPTION},
+    {FreshnessSlot::CHARGING_LIMIT_REACHED, "AT+LIMREACH?", BootStage::TELEMETRY, POLL_EVERY_UPDATE,
+     SlotFormat::FLAG, EntityId::CHARGING_LIMIT_REACHED},
+    {FreshnessSlot::WIFI_STATUS, "AT+WIFISTACONN?", BootStage::TELEMETRY, POLL_EVERY_UPDATE, SlotFormat::CUSTOM,
+     EntityId::NONE},
+    {FreshnessSlot::HEAP, "AT+HEAP?", BootStage::TELEMETRY, POLL_EVERY_UPDATE, SlotFormat::CUSTOM, EntityId::NONE},
+    {FreshnessSlot::UPTIME, "AT+UPTIME?", BootStage::TELEMETRY, POLL_EVERY_UPDATE, SlotFormat::INTEGER,
+     EntityId::UPTIME},
+    {FreshnessSlot::EMETER_THREE_PHASE, "AT+EMETERTHREEPHASE?", BootStage::SETTINGS, kSlowPollIntervalMs,
+     SlotFormat::FLAG, EntityId::EMETER_THREE_PHASE},
+    {FreshnessSlot::MAXIMUM_CHARGING_CURRENT, "AT+MAXCHCUR?", BootStage::SETTINGS, kSlowPollIntervalMs,
+     SlotFormat::CUSTOM, EntityId::MAXIMUM_CHARGING_CURRENT},
+    {FreshnessSlot::DEFAULT_CHARGING_CURRENT, "AT+DEFCHCUR?", BootStage::SETTINGS, kSlowPollIntervalMs,
+     SlotFormat::INTEGER, EntityId::DEFAULT_CHARGING_CURRENT},
+    {FreshnessSlot::CONSUMPTION_LIMIT, "AT+CONSUMLIM?", BootStage::SETTINGS, POLL_EVERY_UPDATE, SlotFormat::FIXED,
+     EntityId::CONSUMPTION_LIMIT},
+    {FreshnessSlot::DEFAULT_CONSUMPTION_LIMIT, "AT+DEFCONSUMLIM?", BootStage::SETTINGS, kSlowPollIntervalMs,
+     SlotFormat::FIXED, EntityId::DEFAULT_CONSUMPTION_LIMIT},
+    {FreshnessSlot::CHARGING_TIME_LIMIT, "AT+CHTIMELIM?", BootStage::SETTINGS, POLL_EVERY_UPDATE,
+     SlotFormat::INTEGER, EntityId::CHARGING_TIME_LIMIT},
+    {FreshnessSlot::DEFAULT_CHARGING_TIME_LIMIT, "AT+DEFCHTIMELIM?", BootStage::SETTINGS, kSlowPollIntervalMs,
+     SlotFormat::INTEGER, EntityId::DEFAULT_CHARGING_TIME_LIMIT},
+    {FreshnessSlot::UNDER_POWER_LIMIT, "AT+UNDERPOWERLIM?", BootStage::SETTINGS, POLL_EVERY_UPDATE,
+     SlotFormat::FIXED, EntityId::UNDER_POWER_LIMIT},
+    {FreshnessSlot::DEFAULT_UNDER_POWER_LIMIT, "AT+DEFUNDERPOWERLIM?", BootStage::SETTINGS, kSlowPollIntervalMs,
+     SlotFormat::FIXED, EntityId::DEFAULT_UNDER_POWER_LIMIT},
+    {FreshnessSlot::CHIP, "AT+CHIP?", BootStage::IDENTITY, POLL_ONCE, SlotFormat::CUSTOM, EntityId::CHIP},
+    {FreshnessSlot::VERSION, "AT+VER?", BootStage::IDENTITY, POLL_ONCE, SlotFormat::CUSTOM, EntityId::VERSION},
+    {FreshnessSlot::IDF_VERSION, "AT+IDFVER?", BootStage::IDENTITY, POLL_ONCE, SlotFormat::TEXT,
+     EntityId::IDF_VERSION},
+    {FreshnessSlot::BUILD_TIME, "AT+BUILDTIME?", BootStage::IDENTITY, POLL_ONCE, SlotFormat::CUSTOM,
+     EntityId::BUILD_TIME},
+    {FreshnessSlot::DEVICE_TIME, "AT+TIME?", BootStage::IDENTITY, POLL_EVERY_UPDATE, SlotFormat::CUSTOM,
+     EntityId::DEVICE_TIME},
+    {FreshnessSlot::WIFI_STA_CFG, "AT+WIFISTACFG?", BootStage::IDENTITY, kSlowPollIntervalMs, SlotFormat::CUSTOM,
+     EntityId::WIFI_STA_SSID},
+    {FreshnessSlot::WIFI_STA_IP, "AT+WIFISTAIP?", BootStage::IDENTITY, POLL_EVERY_UPDATE, SlotFormat::TEXT,
+     EntityId::WIFI_STA_IP},
+    {FreshnessSlot::WIFI_STA_MAC, "AT+WIFISTAMAC?", BootStage::IDENTITY, POLL_ONCE, SlotFormat::TEXT,
+     EntityId::WIFI_STA_MAC},
+    {FreshnessSlot::DEVICE_NAME, "AT+DEVNAME?", BootStage::IDENTITY, kSlowPollIntervalMs, SlotFormat::TEXT,
+     EntityId::DEVICE_NAME},
+};
+
+constexpr ESP32EVSEComponent::SwitchWrite ESP32EVSEComponent::SWITCH_WRITES[4] = {
+    {PendingCommand::Type::ENABLE_WRITE, EntityId::ENABLE, FreshnessSlot::ENABLE},
+    {PendingCommand::Type::AVAILABLE_WRITE, EntityId::AVAILABLE, FreshnessSlot::AVAILABLE},
+    {PendingCommand::Type::REQUEST_AUTHORIZATION_WRITE, EntityId::REQUEST_AUTHORIZATION,
+     FreshnessSlot::REQUEST_AUTHORIZATION},
+    {PendingCommand::Type::EMETER_THREE_PHASE_WRITE, EntityId::EMETER_THREE_PHASE, FreshnessSlot::EMETER_THREE_PHASE},
+};
 
 // Called once at boot to schedule initial state requests from the EVSE.
 void ESP32EVSEComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 EVSE component");
-  this->read_buffer_.reserve(kMaxLineLength);
-
-  this->set_timeout(1000, [this]() {
-    this->request_state_update();
-    this->request_enable_update();
-    this->request_pending_authorization_update();
-    if (this->has_error_binary_sensors_())
-      this->request_error_flags_update();
-
-    if (this->temperature_high_sensor_ != nullptr || this->temperature_low_sensor_ != nullptr)
-      this->request_temperature_update();
-    if (this->charging_current_number_ != nullptr)
-      this->request_charging_current_update();
-    if (this->emeter_power_sensor_ != nullptr)
-      this->request_emeter_power_update();
-    if (this->emeter_session_time_sensor_ != nullptr)
-      this->request_emeter_session_time_update();
-    if (this->emeter_charging_time_sensor_ != nullptr)
-      this->request_emeter_charging_time_update();
-    if (this->uptime_sensor_ != nullptr)
-      this->request_uptime_update();
-    if (this->chip_text_sensor_ != nullptr)
-      this->request_chip_update();
-    if (this->version_text_sensor_ != nullptr)
-      this->request_version_update();
-    if (this->idf_version_text_sensor_ != nullptr)
-      this->request_idf_version_update();
-    if (this->build_time_text_sensor_ != nullptr)
-      this->request_build_time_update();
-    if (this->device_time_text_sensor_ != nullptr)
-      this->request_device_time_update();
-    if (this->wifi_sta_ssid_text_sensor_ != nullptr)
-      this->request_wifi_sta_cfg_update();
-    if (this->wifi_sta_ip_text_sensor_ != nullptr)
-      this->request_wifi_sta_ip_update();
-    if (this->wifi_sta_mac_text_sensor_ != nullptr)
-      this->request_wifi_sta_mac_update();
-    if (this->device_name_text_sensor_ != nullptr)
-      this->request_device_name_update();
-    if (this->available_switch_ != nullptr)
-      this->request_available_update();
-    if (this->request_authorization_switch_ != nullptr)
-      this->request_request_authorization_update();
-    if (this->emeter_three_phase_switch_ != nullptr)
-      this->request_emeter_three_phase_update();
-    if (this->heap_used_sensor_ != nullptr || this->heap_total_sensor_ != nullptr)
-      this->request_heap_update();
-    if (this->energy_consumption_sensor_ != nullptr)
-      this->request_energy_consumption_update();
-    if (this->total_energy_consumption_sensor_ != nullptr)
-      this->request_total_energy_consumption_update();
-    if (this->voltage_l1_sensor_ != nullptr || this->voltage_l2_sensor_ != nullptr ||
-        this->voltage_l3_sensor_ != nullptr)
-      this->request_voltage_update();
-    if (this->current_l1_sensor_ != nullptr || this->current_l2_sensor_ != nullptr ||
-        this->current_l3_sensor_ != nullptr)
-      this->request_current_update();
-    if (this->wifi_rssi_sensor_ != nullptr || this->wifi_connected_binary_sensor_ != nullptr)
-      this->request_wifi_status_update();
-    if (this->charging_limit_reached_binary_sensor_ != nullptr)
-      this->request_charging_limit_reached_update();
-    if (this->default_charging_current_number_ != nullptr)
-      this->request_default_charging_current_update();
-    if (this->maximum_charging_current_number_ != nullptr)
-      this->request_maximum_charging_current_update();
-    if (this->consumption_limit_number_ != nullptr)
-      this->request_consumption_limit_update();
-    if (this->default_consumption_limit_number_ != nullptr)
-      this->request_default_consumption_limit_update();
-    if (this->charging_time_limit_number_ != nullptr)
-      this->request_charging_time_limit_update();
-    if (this->default_charging_time_limit_number_ != nullptr)
-      this->request_default_charging_time_limit_update();
-    if (this->under_power_limit_number_ != nullptr)
-      this->request_under_power_limit_update();
-    if (this->default_under_power_limit_number_ != nullptr)
-      this->request_default_under_power_limit_update();
-  });
+  // The EVSE may still hold subscriptions from before this device restarted.
+  this->subscriptions_applied_.fill(SUBSCRIPTION_UNKNOWN);
+  // Registration is over; the registry keeps its size from here on.
+  this->entities_.shrink_to_fit();
+  this->publish_text_sensor_state_(EntityId::LINK_STATE, "UP");
+  this->publish_binary_sensor_(EntityId::STALE_DATA, true);
+#ifdef USE_ESP32EVSE_WARM_START
+  if (this->warm_start_save_interval_ms_ != 0) {
+    this->warm_start_pref_ = global_preferences->make_preference<WarmStartSnapshot>(
+        fnv1_hash("esp32evse_warm_start_" + this->warm_start_key_), true);
+    if (this->warm_start_pref_.load(&this->warm_start_) && this->warm_start_.magic == kWarmStartMagic) {
+      this->restore_warm_start_();
+    } else {
+      this->warm_start_ = WarmStartSnapshot{};
+    }
+  }
+#endif
+#ifdef USE_ESP32EVSE_TELEMETRY
+  if (this->telemetry_channels_ != 0)
+    this->telemetry_.init(this->telemetry_buffer_bytes_, this->telemetry_interval_ms_);
+#endif
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+  if (this->fuse_limit_tenths_ > 0) {
+    const uint32_t now = millis();
+    for (uint8_t phase = 0; phase < this->grid_current_sensors_.size(); ++phase) {
+      // No reading yet; the grid timeout runs from boot.
+      this->grid_current_amps_[phase] = NAN;
+      this->grid_sample_ms_[phase] = now;
+      if (this->grid_current_sensors_[phase] != nullptr) {
+        this->grid_current_sensors_[phase]->add_on_state_callback(
+            [this, phase](float amps) { this->handle_grid_sample_(phase, amps); });
+      }
+    }
+    this->require_slot(FreshnessSlot::CURRENT);
+    this->request_subscription("+EMETERCURRENT", kLoadManagementOwner, kLoadManagementCurrentPeriodMs);
+  }
+#endif
+
+  if (this->has_entity_(EntityId::SESSION_ENERGY)) {
+    this->require_slot(FreshnessSlot::EMETER_POWER);
+    this->require_slot(FreshnessSlot::ENERGY_CONSUMPTION);
+  }
+
+  // No settling delay: a link that is not up yet simply times out into
+  // ``DOWN``, and the staged startup restarts once the EVSE answers again.
+  this->boot_stage_ = BootStage::CONTROL;
+  this->queue_boot_stage_(BootStage::CONTROL);
+}
+
+// Queue the queries of one startup stage.  Control data comes first so the
+// first screen can show the charger state as early as possible; telemetry,
+// adjustable settings and the static identity strings follow in that order.
+void ESP32EVSEComponent::queue_boot_stage_(BootStage stage) {
+  // Subscriptions mostly push telemetry, so they start with that stage.
+  if (stage == BootStage::TELEMETRY) {
+    this->subscriptions_started_ = true;
+    this->sync_subscriptions_();
+  }
+  for (const SlotQuery &query : SLOT_QUERIES) {
+    if (query.stage != stage)
+      continue;
+#ifdef USE_ESP32EVSE_WARM_START
+    // The static data the fingerprint vouches for waits for the verdict.
+    if (this->fingerprint_ == Fingerprint::PENDING && this->defers_to_fingerprint_(query.slot))
+      continue;
+#endif
+    if (this->is_slot_polled_(query.slot))
+      this->send_slot_query_(query);
+  }
+}
+
+void ESP32EVSEComponent::advance_boot_stage_() {
+  this->boot_stage_ = static_cast<BootStage>(static_cast<uint8_t>(this->boot_stage_) + 1);
+  this->check_state_ready_();
+  if (this->boot_stage_ == BootStage::DONE) {
+    ESP_LOGD(TAG, "Startup queries finished after %" PRIu32 " ms", millis());
+    return;
+  }
+  this->queue_boot_stage_(this->boot_stage_);
+}
+
+// Called when the control stage drains and on every ``+STATE`` afterwards, so
+// a control stage that failed still reports readiness once the state arrives.
+void ESP32EVSEComponent::check_state_ready_() {
+  if (this->state_ready_ || this->boot_stage_ == BootStage::CONTROL ||
+      this->last_response_millis_[static_cast<size_t>(FreshnessSlot::STATE)] == 0)
+    return;
+  this->state_ready_ = true;
+  this->time_to_first_state_ms_ = millis();
+  ESP_LOGI(TAG, "EVSE state ready %" PRIu32 " ms after boot", this->time_to_first_state_ms_);
+  this->publish_sensor_(EntityId::TIME_TO_FIRST_STATE, this->time_to_first_state_ms_);
+  this->state_ready_trigger_.trigger();
+  this->update_stale_data_();
+}
+
+void ESP32EVSEComponent::update_stale_data_() {
+  if (!this->stale_data_ || !this->state_ready_)
+    return;
+#ifdef USE_ESP32EVSE_WARM_START
+  if (this->unconfirmed_slots_ != 0)
+    return;
+#endif
+  this->stale_data_ = false;
+  ESP_LOGD(TAG, "Stale data cleared");
+  this->publish_binary_sensor_(EntityId::STALE_DATA, false);
 }
 
 // Process incoming UART bytes and drive the command queue.  This keeps the ESPHome
@@ -303,39 +854,110 @@ void ESP32EVSEComponent::loop() {
       break;
     size_t to_read = std::min(available, kRxChunkSize);
     this->read_array(rx_buffer, to_read);
-    for (size_t i = 0; i < to_read; ++i) {
-      char c = static_cast<char>(rx_buffer[i]);
-      if (c == '\n' || c == '\r') {
-        if (!this->read_buffer_.empty()) {
-          this->process_line_(this->read_buffer_);
-          this->read_buffer_.clear();
-        }
-      } else {
-        this->read_buffer_.push_back(c);
-        if (this->read_buffer_.size() > kMaxLineLength) {
-          ESP_LOGW(TAG, "Line too long (%zu), discarding partial data", this->read_buffer_.size());
-          this->read_buffer_.clear();
-        }
-      }
-    }
+    this->consume_rx_chunk_(reinterpret_cast<char *>(rx_buffer), to_read);
   }
 
+  // Each in-flight command carries its own send timestamp.  ACKs are matched
+  // in FIFO order, so only the oldest in-flight command can be the next one
+  // to expire.
   const uint32_t now = millis();
+  const uint32_t timeout = this->link_state_ == LinkState::DOWN ? kMaxCommandTimeoutMs : this->command_timeout_ms_;
   while (!this->pending_commands_.empty()) {
     auto &front = this->pending_commands_.front();
-    if (!front.sent) {
-      this->process_next_command_();
+    if (!front.sent || now - front.start_time < timeout)
       break;
-    }
-    if (now - front.start_time < 5000) {
-      break;
-    }
     ESP_LOGW(TAG, "Command '%s' timed out", front.command.c_str());
-    if (this->timeout_fault_binary_sensor_ != nullptr) {
-      this->timeout_fault_binary_sensor_->publish_state(true);
-    }
+    this->publish_binary_sensor_(EntityId::TIMEOUT_FAULT, true);
+    // The abandoned command may still be answered; nothing else is sent until
+    // a probe has realigned replies and commands.
+    this->resyncing_ = true;
     this->handle_ack_(false, true);
   }
+  if (this->resyncing_ && this->link_state_ != LinkState::DOWN &&
+      !this->is_write_queued_(PendingCommand::Type::PROBE))
+    this->queue_probe_();
+
+  // Startup stages follow each other as soon as the previous one is answered.
+  if (this->boot_stage_ != BootStage::DONE && this->link_state_ != LinkState::DOWN &&
+      this->pending_commands_.empty())
+    this->advance_boot_stage_();
+
+  if (this->link_state_ == LinkState::DOWN && this->pending_commands_.empty() &&
+      now - this->last_probe_ms_ >= this->probe_backoff_ms_) {
+    this->last_probe_ms_ = now;
+    this->probe_backoff_ms_ = std::min(this->probe_backoff_ms_ * 2, kMaxProbeIntervalMs);
+    ESP_LOGD(TAG, "Probing ESP32-EVSE link (next probe in %" PRIu32 " ms)", this->probe_backoff_ms_);
+    this->queue_probe_();
+  }
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+  // Grid samples drive the controller; this catches a meter that went quiet
+  // and increases that were held back by ``min_change_interval``.
+  if (this->fuse_limit_tenths_ > 0)
+    this->run_load_management_(now, false);
+#endif
+#ifdef USE_ESP32EVSE_TELEMETRY
+  if (this->telemetry_dump_.active)
+    this->continue_telemetry_dump_();
+#endif
+  // After the line handlers, so entities already show the confirmed values.
+  this->update_stale_data_();
+  this->process_next_command_();
+}
+
+// Split a freshly read UART chunk into lines.  Lines that start and end inside
+// the chunk are dispatched straight from it by overwriting the terminator with
+// ``\0``; only fragments that straddle two reads are copied into
+// ``read_buffer_``.  Either way ``process_line_`` receives a NUL-terminated view
+// and the receive path never touches the heap.
+void ESP32EVSEComponent::consume_rx_chunk_(char *data, size_t length) {
+  char *cursor = data;
+  char *const end = data + length;
+  while (cursor < end) {
+    char *eol = find_line_end(cursor, static_cast<size_t>(end - cursor));
+    if (eol == nullptr) {
+      this->append_partial_line_(cursor, static_cast<size_t>(end - cursor));
+      return;
+    }
+    size_t segment = static_cast<size_t>(eol - cursor);
+    if (this->read_length_ == 0) {
+      if (segment > 0) {
+        *eol = '\0';
+        this->handle_line_(std::string_view(cursor, segment));
+      }
+    } else {
+      this->append_partial_line_(cursor, segment);
+      if (this->read_length_ > 0) {
+        this->read_buffer_[this->read_length_] = '\0';
+        this->handle_line_(std::string_view(this->read_buffer_.data(), this->read_length_));
+        this->read_length_ = 0;
+      }
+    }
+    cursor = eol + 1;
+  }
+}
+
+void ESP32EVSEComponent::handle_line_(std::string_view line) {
+#ifdef USE_ESP32EVSE_PARSER_STATS
+  const uint32_t start_us = micros();
+  const uint32_t start_cycles = arch_get_cpu_cycle_count();
+  this->process_line_(line);
+  const uint32_t elapsed_cycles = arch_get_cpu_cycle_count() - start_cycles;
+  this->record_line_stats_(line, micros() - start_us, elapsed_cycles);
+#else
+  this->process_line_(line);
+#endif
+}
+
+void ESP32EVSEComponent::append_partial_line_(const char *data, size_t length) {
+  if (length == 0)
+    return;
+  if (this->read_length_ + length > MAX_LINE_LENGTH) {
+    ESP_LOGW(TAG, "Line too long (%zu), discarding partial data", this->read_length_ + length);
+    this->read_length_ = 0;
+    return;
+  }
+  memcpy(this->read_buffer_.data() + this->read_length_, data, length);
+  this->read_length_ += length;
 }
 
 // Remember when the EVSE last answered a query.  Fresh slots allow the periodic
@@ -346,12 +968,17 @@ void ESP32EVSEComponent::mark_response_received_(FreshnessSlot slot) {
   if (index >= this->last_response_millis_.size())
     return;
   this->last_response_millis_[index] = millis();
+#ifdef USE_ESP32EVSE_WARM_START
+  this->unconfirmed_slots_ &= ~slot_bit_(slot);
+#endif
 }
 
-// Return ``true`` when the most recent response in ``slot`` is still within the
-// freshness window (half of the configured polling interval).  Callers can then
-// skip sending duplicate commands and keep the UART queue short for sensors that
-// require a full round trip.
+// Return ``true`` when the most recent response in ``slot`` is still fresh
+// enough for this poll.  By default a slot is fresh for half of the configured
+// polling interval, so subscription-backed sensors avoid redundant AT
+// commands.  Slots with a longer poll interval stay fresh until the first poll
+// that is due for them, and ``POLL_ONCE`` slots stay fresh until the EVSE
+// reboots.
 bool ESP32EVSEComponent::should_skip_poll_(FreshnessSlot slot) const {
   size_t index = static_cast<size_t>(slot);
   if (index >= this->last_response_millis_.size())
@@ -359,6 +986,9 @@ bool ESP32EVSEComponent::should_skip_poll_(FreshnessSlot slot) const {
   uint32_t last = this->last_response_millis_[index];
   if (last == 0)
     return false;
+  const uint32_t poll_interval = this->get_poll_interval_(slot);
+  if (poll_interval == POLL_ONCE)
+    return true;
   uint32_t interval = this->get_update_interval();
   if (interval == 0)
     interval = kDefaultUpdateIntervalMs;
@@ -367,6 +997,10 @@ bool ESP32EVSEComponent::should_skip_poll_(FreshnessSlot slot) const {
   if (interval > kMaxUpdateIntervalMs)
     interval = kMaxUpdateIntervalMs;
   uint32_t freshness_window = interval / 2;
+  // Polls only happen on ``update()`` ticks, so give up half a tick to land on
+  // the first tick at or after the requested spacing.
+  if (poll_interval > interval)
+    freshness_window = poll_interval - interval / 2;
   if (freshness_window == 0)
     freshness_window = 1;
   uint32_t now_ms = millis();
@@ -374,124 +1008,53 @@ bool ESP32EVSEComponent::should_skip_poll_(FreshnessSlot slot) const {
   return elapsed < freshness_window;
 }
 
+// Interval from ``SLOT_QUERIES`` unless the YAML overrides it.
+uint32_t ESP32EVSEComponent::get_poll_interval_(FreshnessSlot slot) const {
+  size_t index = static_cast<size_t>(slot);
+  if (index < this->poll_intervals_.size() && (this->poll_interval_overrides_ & (uint64_t{1} << index)) != 0)
+    return this->poll_intervals_[index];
+  return index < static_cast<size_t>(FreshnessSlot::SLOT_COUNT) ? SLOT_QUERIES[index].poll_interval_ms
+                                                               : POLL_EVERY_UPDATE;
+}
+
+void ESP32EVSEComponent::set_poll_interval(FreshnessSlot slot, uint32_t interval_ms) {
+  size_t index = static_cast<size_t>(slot);
+  if (index >= this->poll_intervals_.size())
+    return;
+  const uint64_t bit = uint64_t{1} << index;
+  if ((this->poll_interval_overrides_ & bit) == 0 || interval_ms < this->poll_intervals_[index])
+    this->poll_intervals_[index] = interval_ms;
+  this->poll_interval_overrides_ |= bit;
+}
+
 // Periodic refresh triggered by ``PollingComponent`` (60 seconds by default,
 // configurable via ``update_interval``).  Each request checks
 // ``should_skip_poll_`` so freshly updated subscription-backed sensors avoid
 // redundant AT commands.
 void ESP32EVSEComponent::perform_update_(bool force) {
-  if (force || !this->should_skip_poll_(FreshnessSlot::STATE))
-    this->request_state_update();
-  if (force || !this->should_skip_poll_(FreshnessSlot::ENABLE))
-    this->request_enable_update();
-  if (force || !this->should_skip_poll_(FreshnessSlot::PENDING_AUTHORIZATION))
-    this->request_pending_authorization_update();
-  if (this->has_error_binary_sensors_() && (force || !this->should_skip_poll_(FreshnessSlot::ERROR_FLAGS)))
-    this->request_error_flags_update();
-
-  if ((this->temperature_high_sensor_ != nullptr || this->temperature_low_sensor_ != nullptr) &&
-      (force || !this->should_skip_poll_(FreshnessSlot::TEMPERATURE)))
-    this->request_temperature_update();
-  if (this->charging_current_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::CHARGING_CURRENT)))
-    this->request_charging_current_update();
-  if (this->emeter_power_sensor_ != nullptr && (force || !this->should_skip_poll_(FreshnessSlot::EMETER_POWER)))
-    this->request_emeter_power_update();
-  if (this->emeter_session_time_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::EMETER_SESSION_TIME)))
-    this->request_emeter_session_time_update();
-  if (this->emeter_charging_time_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::EMETER_CHARGING_TIME)))
-    this->request_emeter_charging_time_update();
-  if (this->uptime_sensor_ != nullptr && (force || !this->should_skip_poll_(FreshnessSlot::UPTIME)))
-    this->request_uptime_update();
-  if ((this->heap_used_sensor_ != nullptr || this->heap_total_sensor_ != nullptr) &&
-      (force || !this->should_skip_poll_(FreshnessSlot::HEAP)))
-    this->request_heap_update();
-  if (this->energy_consumption_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::ENERGY_CONSUMPTION)))
-    this->request_energy_consumption_update();
-  if (this->total_energy_consumption_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::TOTAL_ENERGY_CONSUMPTION)))
-    this->request_total_energy_consumption_update();
-  if ((this->voltage_l1_sensor_ != nullptr || this->voltage_l2_sensor_ != nullptr ||
-       this->voltage_l3_sensor_ != nullptr) &&
-      (force || !this->should_skip_poll_(FreshnessSlot::VOLTAGE)))
-    this->request_voltage_update();
-  if ((this->current_l1_sensor_ != nullptr || this->current_l2_sensor_ != nullptr ||
-       this->current_l3_sensor_ != nullptr) &&
-      (force || !this->should_skip_poll_(FreshnessSlot::CURRENT)))
-    this->request_current_update();
-  if ((this->wifi_rssi_sensor_ != nullptr || this->wifi_connected_binary_sensor_ != nullptr) &&
-      (force || !this->should_skip_poll_(FreshnessSlot::WIFI_STATUS)))
-    this->request_wifi_status_update();
-  if (this->charging_limit_reached_binary_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::CHARGING_LIMIT_REACHED)))
-    this->request_charging_limit_reached_update();
-  if (this->available_switch_ != nullptr && (force || !this->should_skip_poll_(FreshnessSlot::AVAILABLE)))
-    this->request_available_update();
-  if (this->request_authorization_switch_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::REQUEST_AUTHORIZATION)))
-    this->request_request_authorization_update();
-  if (this->emeter_three_phase_switch_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::EMETER_THREE_PHASE)))
-    this->request_emeter_three_phase_update();
-
-  // Slow-changing parameters are also requested every poll.  The
-  // ``should_skip_poll_`` guard prevents redundant commands when a subscription
-  // delivered fresher data moments earlier.
-  if (this->default_charging_current_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::DEFAULT_CHARGING_CURRENT)))
-    this->request_default_charging_current_update();
-  if (this->maximum_charging_current_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::MAXIMUM_CHARGING_CURRENT)))
-    this->request_maximum_charging_current_update();
-  if (this->consumption_limit_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::CONSUMPTION_LIMIT)))
-    this->request_consumption_limit_update();
-  if (this->default_consumption_limit_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::DEFAULT_CONSUMPTION_LIMIT)))
-    this->request_default_consumption_limit_update();
-  if (this->charging_time_limit_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::CHARGING_TIME_LIMIT)))
-    this->request_charging_time_limit_update();
-  if (this->default_charging_time_limit_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::DEFAULT_CHARGING_TIME_LIMIT)))
-    this->request_default_charging_time_limit_update();
-  if (this->under_power_limit_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::UNDER_POWER_LIMIT)))
-    this->request_under_power_limit_update();
-  if (this->default_under_power_limit_number_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::DEFAULT_UNDER_POWER_LIMIT)))
-    this->request_default_under_power_limit_update();
-  if (this->wifi_sta_ssid_text_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::WIFI_STA_CFG)))
-    this->request_wifi_sta_cfg_update();
-  if (this->wifi_sta_ip_text_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::WIFI_STA_IP)))
-    this->request_wifi_sta_ip_update();
-  if (this->wifi_sta_mac_text_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::WIFI_STA_MAC)))
-    this->request_wifi_sta_mac_update();
-  if (this->device_name_text_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::DEVICE_NAME)))
-    this->request_device_name_update();
-  if (this->chip_text_sensor_ != nullptr && (force || !this->should_skip_poll_(FreshnessSlot::CHIP)))
-    this->request_chip_update();
-  if (this->version_text_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::VERSION)))
-    this->request_version_update();
-  if (this->idf_version_text_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::IDF_VERSION)))
-    this->request_idf_version_update();
-  if (this->build_time_text_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::BUILD_TIME)))
-    this->request_build_time_update();
-  if (this->device_time_text_sensor_ != nullptr &&
-      (force || !this->should_skip_poll_(FreshnessSlot::DEVICE_TIME)))
-    this->request_device_time_update();
-}
-
-void ESP32EVSEComponent::update() { this->perform_update_(false); }
+  for (const SlotQuery &query : SLOT_QUERIES) {
+    if (this->is_slot_polled_(query.slot) && (force || !this->should_skip_poll_(query.slot)))
+      this->send_slot_query_(query);
+  }
+}
+
+void ESP32EVSEComponent::update() {
+#ifdef USE_ESP32EVSE_PARSER_STATS
+  this->log_parser_stats_();
+#endif
+  this->publish_command_stats_();
+  this->report_malformed_lines_();
+  // The staged startup already queries everything once.
+  if (this->boot_stage_ != BootStage::DONE)
+    return;
+  // Retry subscription changes that failed or did not fit the queue.
+  if (this->subscriptions_dirty_)
+    this->sync_subscriptions_();
+#ifdef USE_ESP32EVSE_WARM_START
+  this->save_warm_start_();
+#endif
+  this->perform_update_(false);
+}
 
 void ESP32EVSEComponent::force_update() { this->perform_update_(true); }
 
@@ -520,83 +1083,608 @@ void ESP32EVSEComponent::dump_config() {
   if (interval > kMaxUpdateIntervalMs)
     interval = kMaxUpdateIntervalMs;
   ESP_LOGCONFIG(TAG, "Update Interval: %u ms (%.1f s)", interval, interval / 1000.0f);
+  ESP_LOGCONFIG(TAG, "Command Queue Size: %u", static_cast<unsigned>(PendingCommandQueue::CAPACITY));
+  ESP_LOGCONFIG(TAG, "Command Window: %u", this->command_window_);
+  ESP_LOGCONFIG(TAG, "Command Timeout: %" PRIu32 " ms (adaptive, %" PRIu32 "-%" PRIu32 " ms)",
+                this->command_timeout_ms_, kMinCommandTimeoutMs, kMaxCommandTimeoutMs);
+  this->log_command_stats_();
+  ESP_LOGCONFIG(TAG, "Registered Entities: %u", static_cast<unsigned>(this->entities_.size()));
+  for (const auto &request : this->subscription_requests_) {
+    ESP_LOGCONFIG(TAG, "  Subscription +%.*s: %" PRIu32 " ms (%s)",
+                  static_cast<int>(kResponseKeyNames[request.target].size()),
+                  kResponseKeyNames[request.target].data(), request.period_ms, request.owner.c_str());
+  }
+  for (size_t i = 0; i < this->poll_intervals_.size(); ++i) {
+    if ((this->poll_interval_overrides_ & (uint64_t{1} << i)) == 0)
+      continue;
+    uint32_t poll_interval = this->poll_intervals_[i];
+    if (poll_interval == POLL_ONCE) {
+      ESP_LOGCONFIG(TAG, "  Poll Interval (slot %u): once per EVSE boot", static_cast<unsigned>(i));
+    } else if (poll_interval == POLL_EVERY_UPDATE) {
+      ESP_LOGCONFIG(TAG, "  Poll Interval (slot %u): every update", static_cast<unsigned>(i));
+    } else {
+      ESP_LOGCONFIG(TAG, "  Poll Interval (slot %u): %" PRIu32 " ms", static_cast<unsigned>(i), poll_interval);
+    }
+  }
+#ifdef USE_ESP32EVSE_PARSER_STATS
+  ESP_LOGCONFIG(TAG, "Parser Statistics: enabled (logged every update)");
+#endif
+#ifdef USE_ESP32EVSE_TELEMETRY
+  if (this->telemetry_.is_enabled()) {
+    ESP_LOGCONFIG(TAG, "Telemetry: %u bytes, at most one sample per %" PRIu32 " ms, channels 0x%03X",
+                  static_cast<unsigned>(this->telemetry_.get_buffer_size()), this->telemetry_.get_interval(),
+                  this->telemetry_channels_);
+  }
+#endif
+#ifdef USE_ESP32EVSE_WARM_START
+  if (this->warm_start_save_interval_ms_ != 0)
+    ESP_LOGCONFIG(TAG, "Warm Start: snapshot saved at most every %" PRIu32 " ms", this->warm_start_save_interval_ms_);
+#endif
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+  if (this->fuse_limit_tenths_ > 0) {
+    ESP_LOGCONFIG(TAG, "Load Management:");
+    ESP_LOGCONFIG(TAG, "  Fuse Limit: %.1f A, Hysteresis: %.1f A", this->fuse_limit_tenths_ * 0.1f,
+                  this->hysteresis_tenths_ * 0.1f);
+    ESP_LOGCONFIG(TAG, "  Minimum Change Interval: %" PRIu32 " ms", this->min_change_interval_ms_);
+    ESP_LOGCONFIG(TAG, "  Failsafe: %.1f A after %" PRIu32 " ms without grid samples",
+                  this->failsafe_current_tenths_ * 0.1f, this->grid_timeout_ms_);
+    if (!this->has_entity_(EntityId::CHARGING_CURRENT))
+      ESP_LOGW(TAG, "  No charging_current number configured; load management is inactive");
+  }
+#endif
+}
+
+#ifdef USE_ESP32EVSE_PARSER_STATS
+// Parser statistics are bucketed per response key, followed by one bucket each
+// for unhandled lines, ``OK``/``ERROR`` acknowledgements and ``RDY``.
+static_assert(ESP32EVSEComponent::PARSER_STAT_SLOTS == kResponseKeyNames.size() + 3,
+              "PARSER_STAT_SLOTS must cover every response key plus the extra buckets");
+
+void ESP32EVSEComponent::record_line_stats_(std::string_view line, uint32_t elapsed_us, uint32_t elapsed_cycles) {
+  size_t slot;
+  if (line == "OK" || line == "ERROR") {
+    slot = kResponseKeyNames.size() + 1;
+  } else if (line == "RDY") {
+    slot = kResponseKeyNames.size() + 2;
+  } else {
+    const char *value = nullptr;
+    slot = static_cast<size_t>(lookup_response_key(line, &value));
+  }
+  auto &stats = this->parser_stats_;
+  ++stats.lines;
+  stats.total_us += elapsed_us;
+  stats.max_us = std::max(stats.max_us, elapsed_us);
+  stats.total_cycles += elapsed_cycles;
+  ++stats.slot_lines[slot];
+  stats.slot_us[slot] += elapsed_us;
+  stats.slot_cycles[slot] += elapsed_cycles;
+}
+
+// Summarise the lines parsed since the previous call and start a new window.
+// Per-key timings include the publish work done by the update handlers, which
+// is what actually costs time on the HMI node.
+void ESP32EVSEComponent::log_parser_stats_() {
+  auto &stats = this->parser_stats_;
+  const uint32_t now = millis();
+  const uint32_t window_ms = now - stats.window_start_ms;
+  if (stats.lines > 0 && window_ms > 0) {
+    ESP_LOGD(TAG,
+             "Parser: %" PRIu32 " lines in %" PRIu32 " ms (%.2f lines/s), avg %.1f us / %" PRIu32
+             " cycles, max %" PRIu32 " us",
+             stats.lines, window_ms, stats.lines * 1000.0f / window_ms,
+             static_cast<float>(stats.total_us) / stats.lines,
+             static_cast<uint32_t>(stats.total_cycles / stats.lines), stats.max_us);
+    for (size_t i = 0; i < PARSER_STAT_SLOTS; ++i) {
+      if (stats.slot_lines[i] == 0)
+        continue;
+      const char *name;
+      if (i < kResponseKeyNames.size()) {
+        name = kResponseKeyNames[i].data();
+      } else if (i == kResponseKeyNames.size()) {
+        name = "<unhandled>";
+      } else if (i == kResponseKeyNames.size() + 1) {
+        name = "<ack>";
+      } else {
+        name = "<ready>";
+      }
+      // ``micros()`` only resolves whole microseconds; the cycle count is the
+      // precise figure for cheap keys.
+      const float avg_us = static_cast<float>(stats.slot_us[i]) / stats.slot_lines[i];
+      const uint32_t avg_cycles = static_cast<uint32_t>(stats.slot_cycles[i] / stats.slot_lines[i]);
+      ESP_LOGV(TAG, "  %-18s %6" PRIu32 " lines, avg %.1f us / %" PRIu32 " cycles", name, stats.slot_lines[i], avg_us,
+               avg_cycles);
+    }
+  }
+  stats = ParserStats{};
+  stats.window_start_ms = now;
+}
+#endif
+
+#ifdef USE_ESP32EVSE_TELEMETRY
+void TelemetryLog::init(size_t buffer_bytes, uint32_t interval_ms) {
+  this->interval_ms_ = interval_ms;
+  this->blocks_.assign(std::min<size_t>(buffer_bytes / BLOCK_SIZE, NO_BLOCK), Block{});
+  this->next_block_ = 0;
+  this->writers_.fill(Writer{});
+}
+
+// Decimation: readings are summed until ``interval`` has passed since the
+// last stored sample, then their mean is stored.  The first reading of a
+// channel is stored right away.  An eighth of the interval is forgiven so a
+// poll that arrives a few milliseconds early is not folded into the next one.
+void TelemetryLog::record(TelemetryChannel channel, int32_t value, uint32_t now) {
+  if (this->blocks_.empty())
+    return;
+  Writer &writer = this->writers_[static_cast<uint8_t>(channel)];
+  writer.pending_sum += value;
+  ++writer.pending_count;
+  if (writer.has_sample && now - writer.last_ms < this->interval_ms_ - this->interval_ms_ / 8 &&
+      writer.pending_count < std::numeric_limits<uint16_t>::max())
+    return;
+  const auto mean = static_cast<int32_t>(writer.pending_sum / writer.pending_count);
+  writer.pending_sum = 0;
+  writer.pending_count = 0;
+  this->append_(channel, mean, now);
+}
+
+void TelemetryLog::append_(TelemetryChannel channel, int32_t value, uint32_t now) {
+  const auto index = static_cast<uint8_t>(channel);
+  Writer &writer = this->writers_[index];
+  // The open block may have been recycled by another channel in the meantime.
+  if (writer.block != NO_BLOCK && this->blocks_[writer.block].channel == index &&
+      this->blocks_[writer.block].count < std::numeric_limits<uint8_t>::max()) {
+    Block &block = this->blocks_[writer.block];
+    const uint32_t dt = now - writer.last_ms;
+    uint8_t encoded[2 * kMaxVarintBytes];
+    size_t length = put_varint(encoded, zigzag_encode(static_cast<int32_t>(dt - writer.last_dt)));
+    length += put_varint(encoded + length,
+                         zigzag_encode(static_cast<int32_t>(static_cast<uint32_t>(value) -
+                                                            static_cast<uint32_t>(writer.last_value))));
+    if (block.used + length <= PAYLOAD_SIZE) {
+      std::memcpy(block.payload + block.used, encoded, length);
+      block.used += length;
+      ++block.count;
+      writer.last_dt = dt;
+      writer.last_ms = now;
+      writer.last_value = value;
+      return;
+    }
+  }
+  writer.block = this->open_block_(index, value, now);
+  writer.last_dt = 0;
+  writer.last_ms = now;
+  writer.last_value = value;
+  writer.has_sample = true;
+}
+
+uint16_t TelemetryLog::open_block_(uint8_t channel, int32_t value, uint32_t now) {
+  const uint16_t index = this->next_block_;
+  this->next_block_ = static_cast<uint16_t>((this->next_block_ + 1) % this->blocks_.size());
+  Block &block = this->blocks_[index];
+  block = Block{};
+  block.start_ms = now;
+  block.start_value = value;
+  block.channel = channel;
+  return index;
+}
+
+void TelemetryLog::for_each(TelemetryChannel channel, uint32_t window_ms, uint32_t now,
+                            const std::function<void(uint32_t, int32_t)> &callback) const {
+  const auto index = static_cast<uint8_t>(channel);
+  const size_t count = this->blocks_.size();
+  // Blocks are handed out round-robin, so starting at the next one to be
+  // recycled visits them oldest first.
+  for (size_t i = 0; i < count; ++i) {
+    const Block &block = this->blocks_[(this->next_block_ + i) % count];
+    if (block.channel != index)
+      continue;
+    uint32_t timestamp = block.start_ms;
+    uint32_t dt = 0;
+    int32_t value = block.start_value;
+    const uint8_t *cursor = block.payload;
+    const uint8_t *end = block.payload + block.used;
+    for (uint8_t sample = 0;; ++sample) {
+      if (window_ms == 0 || now - timestamp <= window_ms)
+        callback(timestamp, value);
+      uint32_t dod;
+      uint32_t delta;
+      if (sample == block.count || !get_varint(cursor, end, dod) || !get_varint(cursor, end, delta))
+        break;
+      dt += static_cast<uint32_t>(zigzag_decode(dod));
+      timestamp += dt;
+      value = static_cast<int32_t>(static_cast<uint32_t>(value) + static_cast<uint32_t>(zigzag_decode(delta)));
+    }
+  }
 }
 
-// Thin wrappers that enqueue the corresponding AT command.  Keeping them in one
-// place makes it easy to audit which controller features we query.
-void ESP32EVSEComponent::request_state_update() { this->send_command_("AT+STATE?"); }
-void ESP32EVSEComponent::request_enable_update() { this->send_command_("AT+ENABLE?"); }
-void ESP32EVSEComponent::request_temperature_update() { this->send_command_("AT+TEMP?"); }
-void ESP32EVSEComponent::request_charging_current_update() { this->send_command_("AT+CHCUR?"); }
-void ESP32EVSEComponent::request_emeter_power_update() { this->send_command_("AT+EMETERPOWER?"); }
-void ESP32EVSEComponent::request_emeter_session_time_update() {
-  this->send_command_("AT+EMETERSESTIME?");
-}
-void ESP32EVSEComponent::request_emeter_charging_time_update() {
-  this->send_command_("AT+EMETERCHTIME?");
-}
-void ESP32EVSEComponent::request_uptime_update() { this->send_command_("AT+UPTIME?"); }
-void ESP32EVSEComponent::request_chip_update() { this->send_command_("AT+CHIP?"); }
-void ESP32EVSEComponent::request_version_update() { this->send_command_("AT+VER?"); }
-void ESP32EVSEComponent::request_idf_version_update() { this->send_command_("AT+IDFVER?"); }
-void ESP32EVSEComponent::request_build_time_update() { this->send_command_("AT+BUILDTIME?"); }
-void ESP32EVSEComponent::request_device_time_update() { this->send_command_("AT+TIME?"); }
-void ESP32EVSEComponent::request_wifi_sta_cfg_update() { this->send_command_("AT+WIFISTACFG?"); }
-void ESP32EVSEComponent::request_wifi_sta_ip_update() { this->send_command_("AT+WIFISTAIP?"); }
-void ESP32EVSEComponent::request_wifi_sta_mac_update() { this->send_command_("AT+WIFISTAMAC?"); }
-void ESP32EVSEComponent::request_device_name_update() { this->send_command_("AT+DEVNAME?"); }
-void ESP32EVSEComponent::request_available_update() { this->send_command_("AT+AVAILABLE?"); }
-void ESP32EVSEComponent::request_request_authorization_update() {
-  this->send_command_("AT+REQAUTH?");
-}
-void ESP32EVSEComponent::request_emeter_three_phase_update() {
-  this->send_command_("AT+EMETERTHREEPHASE?");
-}
-void ESP32EVSEComponent::request_heap_update() { this->send_command_("AT+HEAP?"); }
-void ESP32EVSEComponent::request_energy_consumption_update() {
-  this->send_command_("AT+EMETERCONSUM?");
-}
-void ESP32EVSEComponent::request_total_energy_consumption_update() {
-  this->send_command_("AT+EMETERTOTCONSUM?");
-}
-void ESP32EVSEComponent::request_voltage_update() { this->send_command_("AT+EMETERVOLTAGE?"); }
-void ESP32EVSEComponent::request_current_update() { this->send_command_("AT+EMETERCURRENT?"); }
-void ESP32EVSEComponent::request_wifi_status_update() { this->send_command_("AT+WIFISTACONN?"); }
-void ESP32EVSEComponent::request_default_charging_current_update() {
-  this->send_command_("AT+DEFCHCUR?");
-}
-void ESP32EVSEComponent::request_maximum_charging_current_update() {
-  this->send_command_("AT+MAXCHCUR?");
+uint32_t TelemetryLog::get_sample_count() const {
+  uint32_t samples = 0;
+  for (const auto &block : this->blocks_) {
+    if (block.channel != CHANNEL_FREE)
+      samples += block.count + 1u;
+  }
+  return samples;
 }
-void ESP32EVSEComponent::request_consumption_limit_update() {
-  this->send_command_("AT+CONSUMLIM?");
+
+void ESP32EVSEComponent::set_telemetry(size_t buffer_bytes, uint32_t interval_ms, uint16_t channel_mask) {
+  this->telemetry_buffer_bytes_ = buffer_bytes;
+  this->telemetry_interval_ms_ = interval_ms;
+  this->telemetry_channels_ = channel_mask;
+  // Recorded channels are polled even without an entity attached.
+  for (uint8_t i = 0; i < TELEMETRY_CHANNEL_COUNT; ++i) {
+    if ((channel_mask & (1u << i)) != 0)
+      this->require_slot(kTelemetryChannels[i].slot);
+  }
 }
-void ESP32EVSEComponent::request_default_consumption_limit_update() {
-  this->send_command_("AT+DEFCONSUMLIM?");
+
+void ESP32EVSEComponent::record_telemetry_(TelemetryChannel channel, int64_t value) {
+  if ((this->telemetry_channels_ & telemetry_bit(channel)) == 0)
+    return;
+  const auto clamped = std::clamp<int64_t>(value, std::numeric_limits<int32_t>::min(),
+                                           std::numeric_limits<int32_t>::max());
+  this->telemetry_.record(channel, static_cast<int32_t>(clamped), millis());
 }
-void ESP32EVSEComponent::request_charging_time_limit_update() {
-  this->send_command_("AT+CHTIMELIM?");
+
+void ESP32EVSEComponent::for_each_telemetry_sample(TelemetryChannel channel, uint32_t window_ms,
+                                                   const std::function<void(uint32_t, float)> &callback) const {
+  const float scale = kTelemetryChannels[static_cast<uint8_t>(channel)].scale;
+  this->telemetry_.for_each(channel, window_ms, millis(), [&](uint32_t timestamp, int32_t value) {
+    callback(timestamp, static_cast<float>(value) * scale);
+  });
 }
-void ESP32EVSEComponent::request_default_charging_time_limit_update() {
-  this->send_command_("AT+DEFCHTIMELIM?");
+
+void ESP32EVSEComponent::dump_telemetry(uint32_t window_ms, uint16_t channel_mask) {
+  if (!this->telemetry_.is_enabled()) {
+    ESP_LOGW(TAG, "Telemetry log is not configured");
+    return;
+  }
+  if (channel_mask == 0)
+    channel_mask = this->telemetry_channels_;
+  auto &dump = this->telemetry_dump_;
+  dump = TelemetryDump{};
+  dump.active = true;
+  dump.channel_mask = channel_mask & this->telemetry_channels_;
+  dump.now = millis();
+  dump.window_ms = window_ms;
+  this->continue_telemetry_dump_();
 }
-void ESP32EVSEComponent::request_under_power_limit_update() {
-  this->send_command_("AT+UNDERPOWERLIM?");
+
+void ESP32EVSEComponent::continue_telemetry_dump_() {
+  auto &dump = this->telemetry_dump_;
+  uint16_t budget = kTelemetryDumpLinesPerLoop;
+  while (budget > 0) {
+    if (dump.channel >= TELEMETRY_CHANNEL_COUNT) {
+      ESP_LOGI(TAG, "Telemetry: %" PRIu32 " samples stored in %u bytes", this->telemetry_.get_sample_count(),
+               static_cast<unsigned>(this->telemetry_.get_buffer_size()));
+      dump.active = false;
+      return;
+    }
+    const auto channel = static_cast<TelemetryChannel>(dump.channel);
+    if ((dump.channel_mask & telemetry_bit(channel)) == 0) {
+      ++dump.channel;
+      continue;
+    }
+    const auto &info = kTelemetryChannels[dump.channel];
+    if (!dump.channel_started) {
+      ESP_LOGI(TAG, "Telemetry %s [%s]:", info.name, info.unit);
+      dump.channel_started = true;
+      dump.has_last = false;
+      --budget;
+      continue;
+    }
+    // Decoding is cheap next to logging, so each pass walks the channel from
+    // the start and skips what was already logged.
+    bool more = false;
+    this->telemetry_.for_each(channel, dump.window_ms, dump.now, [&](uint32_t timestamp, int32_t value) {
+      if (static_cast<int32_t>(timestamp - dump.now) > 0 ||
+          (dump.has_last && static_cast<int32_t>(timestamp - dump.last_timestamp) <= 0))
+        return;
+      if (budget == 0) {
+        more = true;
+        return;
+      }
+      ESP_LOGI(TAG, "  %9.1f s  %.3f", -static_cast<float>(dump.now - timestamp) / 1000.0f,
+               static_cast<float>(value) * info.scale);
+      dump.last_timestamp = timestamp;
+      dump.has_last = true;
+      --budget;
+    });
+    if (!more) {
+      ++dump.channel;
+      dump.channel_started = false;
+    }
+  }
 }
-void ESP32EVSEComponent::request_default_under_power_limit_update() {
-  this->send_command_("AT+DEFUNDERPOWERLIM?");
+#endif
+
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+void ESP32EVSEComponent::set_load_management(float fuse_limit, float hysteresis, uint32_t min_change_interval_ms,
+                                             uint32_t timeout_ms, float failsafe_current) {
+  this->fuse_limit_tenths_ = static_cast<int32_t>(std::lroundf(fuse_limit * 10.0f));
+  this->hysteresis_tenths_ = static_cast<int32_t>(std::lroundf(hysteresis * 10.0f));
+  this->min_change_interval_ms_ = min_change_interval_ms;
+  this->grid_timeout_ms_ = timeout_ms;
+  this->failsafe_current_tenths_ = static_cast<int32_t>(std::lroundf(failsafe_current * 10.0f));
 }
-void ESP32EVSEComponent::request_pending_authorization_update() {
-  this->send_command_("AT+PENDAUTH?");
+
+void ESP32EVSEComponent::handle_grid_sample_(uint8_t phase, float amps) {
+  // An unavailable meter publishes NaN; leave the old sample to age out.
+  if (std::isnan(amps))
+    return;
+  const uint32_t now = millis();
+  this->grid_current_amps_[phase] = amps;
+  this->grid_sample_ms_[phase] = now;
+  this->run_load_management_(now, true);
+}
+
+// Everything is in tenths of an amp, the resolution of ``AT+CHCUR``.  The grid
+// meter and ``+EMETERCURRENT`` are sampled independently, so right after a
+// change the two disagree about the charger's draw.  The current is therefore
+// only lowered while a phase is actually above the fuse limit, and raising it
+// waits ``min_change_interval`` for the readings to settle.  It is never raised
+// while a phase is over the limit, nor on an own reading older than the last
+// change, which would still count the old, higher draw as headroom.
+void ESP32EVSEComponent::run_load_management_(uint32_t now, bool on_sample) {
+  auto *number = this->number_entity_(EntityId::CHARGING_CURRENT);
+  // Nothing can be written while the link is down; the write that was in
+  // flight has already been reported as failed.
+  if (number == nullptr || this->link_state_ == LinkState::DOWN)
+    return;
+  const auto &own_ma = this->meter_readings_.current_ma;
+  bool stale = false;
+  bool complete = true;
+  bool overloaded = false;
+  int32_t available = std::numeric_limits<int32_t>::max();
+  for (size_t phase = 0; phase < this->grid_current_sensors_.size(); ++phase) {
+    if (this->grid_current_sensors_[phase] == nullptr)
+      continue;
+    const uint32_t age = now - this->grid_sample_ms_[phase];
+    if (age > this->grid_timeout_ms_)
+      stale = true;
+    if (std::isnan(this->grid_current_amps_[phase])) {
+      complete = false;
+      continue;
+    }
+    const int32_t grid = static_cast<int32_t>(std::lroundf(this->grid_current_amps_[phase] * 10.0f));
+    overloaded |= grid > this->fuse_limit_tenths_;
+    const int32_t own = own_ma.has_value() ? static_cast<int32_t>(((*own_ma)[phase] + 50) / 100) : 0;
+    // Whatever the rest of the house draws on this phase is off limits.
+    available = std::min(available, this->fuse_limit_tenths_ - (grid - own));
+  }
+
+  if (stale) {
+    if (this->load_management_state_ != LoadManagementState::FAILSAFE) {
+      ESP_LOGW(TAG, "Load management: no grid samples for %" PRIu32 " ms, falling back to %.1f A",
+               this->grid_timeout_ms_, this->failsafe_current_tenths_ * 0.1f);
+      this->load_management_state_ = LoadManagementState::FAILSAFE;
+    }
+    // Only ever lower the current here; a charger already below the failsafe
+    // value stays where it is.
+    this->load_management_target_tenths_ = this->failsafe_current_tenths_;
+    if (this->charging_current_tenths_ < 0 || this->charging_current_tenths_ > this->failsafe_current_tenths_)
+      this->write_load_management_current_(this->failsafe_current_tenths_, now, 0);
+    return;
+  }
+  if (!complete)
+    return;
+  if (this->load_management_state_ != LoadManagementState::ACTIVE) {
+    ESP_LOGI(TAG, "Load management active");
+    this->load_management_state_ = LoadManagementState::ACTIVE;
+  }
+
+  const int32_t min_tenths = static_cast<int32_t>(std::lroundf(number->traits.get_min_value() * 10.0f));
+  const int32_t max_tenths = static_cast<int32_t>(
+      std::lroundf(this->clamp_charging_current_value(number, number->traits.get_max_value()) * 10.0f));
+  // The EVSE cannot go below its minimum; say so once per shortage.
+  const bool short_of_minimum = available < min_tenths;
+  if (short_of_minimum && !this->load_management_short_) {
+    ESP_LOGW(TAG, "Load management: only %.1f A left, below the %.1f A minimum", available * 0.1f,
+             min_tenths * 0.1f);
+  }
+  this->load_management_short_ = short_of_minimum;
+  const int32_t target = std::clamp(available, min_tenths, std::max(min_tenths, max_tenths));
+  this->load_management_target_tenths_ = target;
+
+  // Reaction times are only measured from the sample that caused the write.
+  const uint32_t sample_ms = on_sample ? now : 0;
+  const int32_t current = this->charging_current_tenths_;
+  if (current < 0 || (overloaded && target < current)) {
+    this->write_load_management_current_(target, now, sample_ms);
+  } else if (!overloaded && target >= current + this->hysteresis_tenths_ &&
+             now - this->last_current_change_ms_ >= this->min_change_interval_ms_ && this->own_current_settled_()) {
+    this->write_load_management_current_(target, now, sample_ms);
+  }
+}
+
+bool ESP32EVSEComponent::own_current_settled_() const {
+  const uint32_t own_ms = this->last_response_millis_[static_cast<size_t>(FreshnessSlot::CURRENT)];
+  return own_ms != 0 && static_cast<int32_t>(own_ms - this->last_current_change_ms_) > 0;
+}
+
+void ESP32EVSEComponent::write_load_management_current_(int32_t tenths, uint32_t now, uint32_t sample_ms) {
+  // One failure fires ``on_write_failed`` once, not on every ``loop()``.
+  if (this->load_management_write_failed_ && now - this->load_management_failed_ms_ < this->min_change_interval_ms_)
+    return;
+  if (!this->write_number_value(this->number_entity_(EntityId::CHARGING_CURRENT), tenths * 0.1f)) {
+    this->load_management_write_failed_ = true;
+    this->load_management_failed_ms_ = now;
+    return;
+  }
+  this->load_management_write_failed_ = false;
+  ESP_LOGD(TAG, "Load management: charging current %.1f A", tenths * 0.1f);
+  this->charging_current_tenths_ = tenths;
+  this->last_current_change_ms_ = now;
+  this->load_management_write_sample_ms_ = sample_ms;
+}
+#endif
+
+#ifdef USE_ESP32EVSE_WARM_START
+void ESP32EVSEComponent::set_warm_start(uint32_t save_interval_ms, const std::string &key) {
+  this->warm_start_save_interval_ms_ = save_interval_ms;
+  this->warm_start_key_ = key;
+}
+
+// Publish the snapshot before the first query goes out.  Values confirmed by
+// the EVSE later replace it; the stale-data sensor stays on until then.
+void ESP32EVSEComponent::restore_warm_start_() {
+  const WarmStartSnapshot &snapshot = this->warm_start_;
+  ESP_LOGI(TAG, "Restoring the last known EVSE state (firmware %s)", snapshot.version);
+  // Every slot published here keeps ``stale_data`` on until it is answered.
+  auto restored = [this](FreshnessSlot slot) {
+    if (this->is_slot_polled_(slot))
+      this->unconfirmed_slots_ |= slot_bit_(slot);
+  };
+  if (snapshot.state[0] != '\0' && this->has_entity_(EntityId::STATE)) {
+    this->publish_text_sensor_state_(EntityId::STATE, snapshot.state);
+    restored(FreshnessSlot::STATE);
+  }
+  if ((snapshot.valid & WARM_START_ENABLE) != 0 && this->has_entity_(EntityId::ENABLE)) {
+    this->publish_switch_(EntityId::ENABLE, snapshot.enable != 0, true);
+    restored(FreshnessSlot::ENABLE);
+  }
+  auto *number = this->number_entity_(EntityId::CHARGING_CURRENT);
+  if ((snapshot.valid & WARM_START_CHARGING_CURRENT) != 0 && number != nullptr) {
+    // Through the publish filter, so the confirming ``+CHCUR`` has a baseline.
+    if (this->should_publish_(EntityId::CHARGING_CURRENT, snapshot.charging_current, true))
+      number->publish_state(snapshot.charging_current);
+    restored(FreshnessSlot::CHARGING_CURRENT);
+  }
+  if ((snapshot.valid & WARM_START_TOTAL_ENERGY) != 0 && this->has_entity_(EntityId::TOTAL_ENERGY_CONSUMPTION)) {
+    this->publish_sensor_(EntityId::TOTAL_ENERGY_CONSUMPTION, static_cast<float>(snapshot.total_energy_wh));
+    restored(FreshnessSlot::TOTAL_ENERGY_CONSUMPTION);
+  }
+  for (FreshnessSlot slot : {FreshnessSlot::VERSION, FreshnessSlot::BUILD_TIME, FreshnessSlot::CHIP,
+                             FreshnessSlot::IDF_VERSION, FreshnessSlot::WIFI_STA_MAC}) {
+    const EntityId id = SLOT_QUERIES[static_cast<size_t>(slot)].entity;
+    const char *value = this->cached_identity_(slot);
+    if (value[0] != '\0' && this->has_entity_(id)) {
+      this->publish_text_sensor_state_(id, value);
+      restored(slot);
+    }
+  }
+  if (snapshot.version[0] != '\0' && snapshot.build_time[0] != '\0')
+    this->fingerprint_ = Fingerprint::PENDING;
 }
-void ESP32EVSEComponent::request_charging_limit_reached_update() {
-  this->send_command_("AT+LIMREACH?");
+
+// Rate limited: the first snapshot is written once the state is ready, later
+// ones at most every ``warm_start_save_interval_ms_``, and only when they
+// differ from the stored one.
+void ESP32EVSEComponent::save_warm_start_() {
+  if (this->warm_start_save_interval_ms_ == 0 || !this->state_ready_)
+    return;
+  const uint32_t now = millis();
+  if (this->warm_start_saved_ && now - this->warm_start_saved_ms_ < this->warm_start_save_interval_ms_)
+    return;
+  WarmStartSnapshot snapshot{};
+  snapshot.magic = kWarmStartMagic;
+  auto copy_text = [this](EntityId id, auto &field) {
+    auto *sensor = this->entity_<text_sensor::TextSensor>(id);
+    if (sensor != nullptr && sensor->has_state())
+      copy_field(field, sensor->get_raw_state());
+  };
+  copy_text(EntityId::STATE, snapshot.state);
+  if (auto *sw = this->entity_<switch_::Switch>(EntityId::ENABLE)) {
+    snapshot.valid |= WARM_START_ENABLE;
+    snapshot.enable = sw->state ? 1 : 0;
+  }
+  auto *number = this->number_entity_(EntityId::CHARGING_CURRENT);
+  if (number != nullptr && number->has_state()) {
+    snapshot.valid |= WARM_START_CHARGING_CURRENT;
+    snapshot.charging_current = number->state;
+  }
+  if (this->meter_readings_.total_energy_wh.has_value()) {
+    snapshot.valid |= WARM_START_TOTAL_ENERGY;
+    snapshot.total_energy_wh = *this->meter_readings_.total_energy_wh;
+  }
+  copy_field(snapshot.version, this->firmware_version_);
+  copy_field(snapshot.build_time, this->firmware_build_time_);
+  // The identity entities keep the restored strings until the EVSE sends new
+  // ones, so a matching fingerprint carries them over unchanged.
+  copy_text(EntityId::CHIP, snapshot.chip);
+  copy_text(EntityId::IDF_VERSION, snapshot.idf_version);
+  copy_text(EntityId::WIFI_STA_MAC, snapshot.wifi_sta_mac);
+  // ``warm_start_`` holds what flash has, if anything.
+  if (this->warm_start_.magic == kWarmStartMagic && std::memcmp(&snapshot, &this->warm_start_, sizeof(snapshot)) == 0)
+    return;
+  if (!this->warm_start_pref_.save(&snapshot)) {
+    ESP_LOGW(TAG, "Could not store the warm-start snapshot");
+    return;
+  }
+  this->warm_start_ = snapshot;
+  this->warm_start_saved_ = true;
+  this->warm_start_saved_ms_ = now;
+  ESP_LOGD(TAG, "Warm-start snapshot stored");
+}
+
+const char *ESP32EVSEComponent::cached_identity_(FreshnessSlot slot) const {
+  switch (slot) {
+    case FreshnessSlot::VERSION:
+      return this->warm_start_.version;
+    case FreshnessSlot::BUILD_TIME:
+      return this->warm_start_.build_time;
+    case FreshnessSlot::CHIP:
+      return this->warm_start_.chip;
+    case FreshnessSlot::IDF_VERSION:
+      return this->warm_start_.idf_version;
+    case FreshnessSlot::WIFI_STA_MAC:
+      return this->warm_start_.wifi_sta_mac;
+    default:
+      return nullptr;
+  }
+}
+
+bool ESP32EVSEComponent::defers_to_fingerprint_(FreshnessSlot slot) const {
+  if (slot == FreshnessSlot::VERSION || slot == FreshnessSlot::BUILD_TIME)
+    return false;
+  const char *cached = this->cached_identity_(slot);
+  return cached != nullptr && cached[0] != '\0' && this->is_slot_polled_(slot) &&
+         this->get_poll_interval_(slot) == POLL_ONCE;
+}
+
+// Compare a fingerprint response against the snapshot.  Once both match, the
+// deferred static slots count as answered for this EVSE boot; a mismatch
+// queries them after all.
+void ESP32EVSEComponent::check_fingerprint_(FreshnessSlot slot, std::string_view value) {
+  const bool is_version = slot == FreshnessSlot::VERSION;
+  if (is_version) {
+    copy_field(this->firmware_version_, value);
+  } else {
+    copy_field(this->firmware_build_time_, value);
+  }
+  if (this->fingerprint_ != Fingerprint::PENDING)
+    return;
+  const char *current = is_version ? this->firmware_version_ : this->firmware_build_time_;
+  if (std::strcmp(current, this->cached_identity_(slot)) != 0) {
+    this->fingerprint_ = Fingerprint::CHANGED;
+    ESP_LOGI(TAG, "EVSE firmware changed since the snapshot; reading its identity again");
+    for (const SlotQuery &query : SLOT_QUERIES) {
+      if (this->defers_to_fingerprint_(query.slot))
+        this->send_slot_query_(query);
+    }
+    return;
+  }
+  this->fingerprint_matched_ |= is_version ? kFingerprintVersion : kFingerprintBuildTime;
+  if (this->fingerprint_matched_ != (kFingerprintVersion | kFingerprintBuildTime))
+    return;
+  this->fingerprint_ = Fingerprint::MATCHED;
+  ESP_LOGD(TAG, "EVSE firmware unchanged; skipping the static identity queries");
+  for (const SlotQuery &query : SLOT_QUERIES) {
+    if (this->defers_to_fingerprint_(query.slot))
+      this->mark_response_received_(query.slot);
+  }
 }
+#endif
 
-void ESP32EVSEComponent::request_error_flags_update() { this->send_command_("AT+ERROR?"); }
+void ESP32EVSEComponent::request_slot_update(FreshnessSlot slot) {
+  static_assert(is_slot_indexed(SLOT_QUERIES), "SLOT_QUERIES must list every freshness slot in enum order");
+  size_t index = static_cast<size_t>(slot);
+  if (index >= static_cast<size_t>(FreshnessSlot::SLOT_COUNT))
+    return;
+  this->send_slot_query_(SLOT_QUERIES[index]);
+}
 
 // Translate ESPHome entity state changes into AT commands.
-void ESP32EVSEComponent::write_enable_state(bool enabled) {
+bool ESP32EVSEComponent::write_enable_state(bool enabled, WriteCallback callback) {
   PendingCommand pending;
   pending.type = PendingCommand::Type::ENABLE_WRITE;
   // Remember the requested state so we can publish it once the EVSE confirms
@@ -604,10 +1692,10 @@ void ESP32EVSEComponent::write_enable_state(bool enabled) {
   pending.bool_value = enabled;
   pending.command.assign("AT+ENABLE=");
   pending.command.append_char(enabled ? '1' : '0');
-  this->queue_pending_command_(pending);
+  return this->queue_with_callback_(pending, std::move(callback));
 }
 
-void ESP32EVSEComponent::write_available_state(bool available) {
+bool ESP32EVSEComponent::write_available_state(bool available, WriteCallback callback) {
   PendingCommand pending;
   pending.type = PendingCommand::Type::AVAILABLE_WRITE;
   // Store the intended availability state so the acknowledgement handler can
@@ -615,10 +1703,10 @@ void ESP32EVSEComponent::write_available_state(bool available) {
   pending.bool_value = available;
   pending.command.assign("AT+AVAILABLE=");
   pending.command.append_char(available ? '1' : '0');
-  this->queue_pending_command_(pending);
+  return this->queue_with_callback_(pending, std::move(callback));
 }
 
-void ESP32EVSEComponent::write_request_authorization_state(bool request) {
+bool ESP32EVSEComponent::write_request_authorization_state(bool request, WriteCallback callback) {
   PendingCommand pending;
   pending.type = PendingCommand::Type::REQUEST_AUTHORIZATION_WRITE;
   // Persist the desired authorization request flag to publish after a
@@ -626,24 +1714,25 @@ void ESP32EVSEComponent::write_request_authorization_state(bool request) {
   pending.bool_value = request;
   pending.command.assign("AT+REQAUTH=");
   pending.command.append_char(request ? '1' : '0');
-  this->queue_pending_command_(pending);
+  return this->queue_with_callback_(pending, std::move(callback));
 }
 
-void ESP32EVSEComponent::write_emeter_three_phase_state(bool enabled) {
+bool ESP32EVSEComponent::write_emeter_three_phase_state(bool enabled, WriteCallback callback) {
   PendingCommand pending;
   pending.type = PendingCommand::Type::EMETER_THREE_PHASE_WRITE;
   pending.bool_value = enabled;
   pending.command.assign("AT+EMETERTHREEPHASE=");
   pending.command.append_char(enabled ? '1' : '0');
-  this->queue_pending_command_(pending);
+  return this->queue_with_callback_(pending, std::move(callback));
 }
 
-void ESP32EVSEComponent::write_charging_current(float current) {
-  this->write_number_value(this->charging_current_number_, current);
+bool ESP32EVSEComponent::write_charging_current(float current, WriteCallback callback) {
+  return this->write_number_value(this->number_entity_(EntityId::CHARGING_CURRENT), current, std::move(callback));
 }
 
 float ESP32EVSEComponent::clamp_charging_current_value(ESP32EVSEChargingCurrentNumber *number, float value) const {
-  if ((number == this->charging_current_number_ || number == this->default_charging_current_number_) &&
+  if ((number == this->number_entity_(EntityId::CHARGING_CURRENT) ||
+       number == this->number_entity_(EntityId::DEFAULT_CHARGING_CURRENT)) &&
       !std::isnan(this->maximum_charging_current_limit_)) {
     // The EVSE only accepts runtime values up to the reported maximum, so cap writes accordingly.
     if (value > this->maximum_charging_current_limit_)
@@ -652,158 +1741,542 @@ float ESP32EVSEComponent::clamp_charging_current_value(ESP32EVSEChargingCurrentN
   return value;
 }
 
-void ESP32EVSEComponent::write_number_value(ESP32EVSEChargingCurrentNumber *number, float value) {
-  if (number == nullptr)
-    return;
+bool ESP32EVSEComponent::write_number_value(ESP32EVSEChargingCurrentNumber *number, float value,
+                                            WriteCallback callback) {
+  if (number == nullptr || number->get_command().empty()) {
+    if (callback)
+      callback(false, 0);
+    return false;
+  }
   const std::string &command = number->get_command();
-  if (command.empty())
-    return;
   value = this->clamp_charging_current_value(number, value);
-  float scaled_value = value * number->get_multiplier();
-  int32_t to_send = static_cast<int32_t>(std::lroundf(scaled_value));
+  int32_t to_send = static_cast<int32_t>(std::lroundf(value * number->get_multiplier()));
   PendingCommand pending;
   pending.type = PendingCommand::Type::NUMBER_WRITE;
   // Retain the target entity and scaled integer the firmware expects so the
   // acknowledgement handler can publish the same reading once the write sticks.
   pending.number = number;
-  pending.scaled_value = static_cast<float>(to_send);
+  pending.scaled_value = to_send;
   pending.command.assign(command);
   pending.command.append_char('=');
   pending.command.append_decimal(to_send);
-  this->queue_pending_command_(pending);
+  return this->queue_with_callback_(pending, std::move(callback));
 }
 
-// Convenience wrappers for popular subscription targets.  They are exposed to
-// users through templated buttons in YAML.
-void ESP32EVSEComponent::at_sub(const std::string &command, uint32_t period_ms) {
-  if (!this->is_valid_subscription_argument_(command)) {
-    ESP_LOGW(TAG,
-             "Rejected AT+SUB wrapper request with argument '%s'; only subscription targets are allowed",
-             command.c_str());
-    return;
+bool ESP32EVSEComponent::queue_with_callback_(PendingCommand &pending, WriteCallback &&callback,
+                                              QueryCallback &&query_callback) {
+  if (callback || query_callback) {
+    // Skip ``0``, which marks commands without callbacks.
+    if (++this->last_callback_id_ == 0)
+      ++this->last_callback_id_;
+    pending.callback_id = this->last_callback_id_;
+    this->command_callbacks_.push_back({pending.callback_id, std::move(callback), std::move(query_callback)});
   }
-  ESP_LOGD(TAG, "Sending AT+SUB for command '%s' with period %" PRIu32 " ms", command.c_str(), period_ms);
-  CommandString cmd;
-  cmd.assign("AT+SUB=");
-  cmd.append(command);
-  cmd.append_char(',');
-  cmd.append_unsigned(period_ms);
-  this->send_command_(cmd);
+  if (!this->queue_pending_command_(pending)) {
+    this->finish_command_(pending, false, 0);
+    return false;
+  }
+  this->show_provisional_(pending);
+  return true;
 }
 
-void ESP32EVSEComponent::at_unsub(const std::string &command) {
-  if (command.empty()) {
-    ESP_LOGD(TAG, "Sending AT+UNSUB with empty command parameter");
-    CommandString cmd;
-    cmd.assign("AT+UNSUB=\"\"");
-    this->send_command_(cmd);
+void ESP32EVSEComponent::show_provisional_(const PendingCommand &pending) {
+  const SwitchWrite *write = switch_write_(pending.type);
+  ESP32EVSEOptimisticEntity *entity = write != nullptr ? this->switch_state_(write->entity) : pending.number;
+  if (entity == nullptr || !entity->is_optimistic())
     return;
+  entity->provisional_ = true;
+  if (write != nullptr) {
+    this->publish_switch_(write->entity, pending.bool_value, true);
+  } else {
+    float value = this->scaled_number_value_(pending.number, pending.scaled_value);
+    if (this->should_publish_(this->number_id_(pending.number), value, true))
+      pending.number->publish_state(value);
   }
+}
 
-  if (!this->is_valid_subscription_argument_(command)) {
-    ESP_LOGW(TAG,
-             "Rejected AT+UNSUB wrapper request with argument '%s'; only subscription targets are allowed",
-             command.c_str());
-    return;
-  }
+bool ESP32EVSEComponent::confirm_value_(ESP32EVSEOptimisticEntity *entity, float value) {
+  entity->confirmed_value_ = value;
+  return !entity->provisional_;
+}
 
-  ESP_LOGD(TAG, "Sending AT+UNSUB for command '%s'", command.c_str());
-  CommandString cmd;
-  cmd.assign("AT+UNSUB=");
-  cmd.append(command);
-  this->send_command_(cmd);
+bool ESP32EVSEComponent::settle_write_(ESP32EVSEOptimisticEntity *entity, const PendingCommand &pending, bool success,
+                                       float value) {
+  if (success)
+    entity->confirmed_value_ = value;
+  // A newer write to the same entity is queued behind this one and is what
+  // the entity shows now.
+  entity->provisional_ = entity->provisional_ && this->is_write_queued_(pending.type, pending.number);
+  return !entity->provisional_;
 }
 
-// Validate that a subscription string only contains characters supported by the
-// EVSE firmware (alphanumeric, plus, underscore, and quotes).
-bool ESP32EVSEComponent::is_valid_subscription_argument_(const std::string &argument) const {
-  if (argument.empty()) {
+bool ESP32EVSEComponent::roll_back_switch_(EntityId id) {
+  ESP32EVSEOptimisticEntity *entity = this->switch_state_(id);
+  if (entity == nullptr || !entity->is_optimistic() || std::isnan(entity->get_confirmed_value()))
     return false;
-  }
-  for (size_t i = 0; i + 2 < argument.size(); ++i) {
-    char c0 = argument[i];
-    char c1 = argument[i + 1];
-    char c2 = argument[i + 2];
-    if ((c0 == 'A' || c0 == 'a') && (c1 == 'T' || c1 == 't') && c2 == '+') {
-      return false;
-    }
-  }
+  this->publish_switch_(id, entity->get_confirmed_value() != 0.0f, true);
   return true;
 }
 
-void ESP32EVSEComponent::send_reset_command() { this->send_command_("AT+RST"); }
+const ESP32EVSEComponent::SwitchWrite *ESP32EVSEComponent::switch_write_(PendingCommand::Type type) {
+  for (const SwitchWrite &write : SWITCH_WRITES) {
+    if (write.type == type)
+      return &write;
+  }
+  return nullptr;
+}
 
-void ESP32EVSEComponent::send_authorize_command() { this->send_command_("AT+AUTH"); }
+// The switch classes only share their bases, so each is cast to its own type.
+ESP32EVSEOptimisticEntity *ESP32EVSEComponent::switch_state_(EntityId id) const {
+  switch (id) {
+    case EntityId::ENABLE:
+      return this->entity_<ESP32EVSEEnableSwitch>(id);
+    case EntityId::AVAILABLE:
+      return this->entity_<ESP32EVSEAvailableSwitch>(id);
+    case EntityId::REQUEST_AUTHORIZATION:
+      return this->entity_<ESP32EVSERequestAuthorizationSwitch>(id);
+    case EntityId::EMETER_THREE_PHASE:
+      return this->entity_<ESP32EVSEEmeterThreePhaseSwitch>(id);
+    default:
+      return nullptr;
+  }
+}
 
-void ESP32EVSEComponent::send_start_ap_command() { this->send_command_("AT+WIFIAPCFG=1"); }
+ESP32EVSEChargingCurrentNumber *ESP32EVSEComponent::number_entity_(EntityId id) const {
+  return this->entity_<ESP32EVSEChargingCurrentNumber>(id);
+}
 
-bool ESP32EVSEComponent::send_command_(const char *command) {
-  if (command == nullptr || command[0] == '\0')
+// Every number slot feeds the number registered under the same name.
+EntityId ESP32EVSEComponent::number_id_(const ESP32EVSEChargingCurrentNumber *number) const {
+  const EntityId id = SLOT_QUERIES[static_cast<size_t>(number->get_slot())].entity;
+  return id != EntityId::NONE && this->number_entity_(id) == number ? id : EntityId::NONE;
+}
+
+void ESP32EVSEComponent::finish_command_(const PendingCommand &pending, bool success, uint32_t latency_ms,
+                                         const std::vector<std::string_view> &lines) {
+  switch (pending.type) {
+    case PendingCommand::Type::ENABLE_WRITE:
+    case PendingCommand::Type::AVAILABLE_WRITE:
+    case PendingCommand::Type::REQUEST_AUTHORIZATION_WRITE:
+    case PendingCommand::Type::EMETER_THREE_PHASE_WRITE:
+    case PendingCommand::Type::NUMBER_WRITE:
+      (success ? this->write_success_trigger_ : this->write_failed_trigger_).trigger(pending.command.c_str(),
+                                                                                     latency_ms);
+      break;
+    case PendingCommand::Type::SUBSCRIPTION:
+    case PendingCommand::Type::PROBE:
+    case PendingCommand::Type::GENERIC:
+    case PendingCommand::Type::RAW:
+      break;
+  }
+  if (pending.callback_id == 0)
+    return;
+  // Take the callbacks out first: they may queue further writes, which append
+  // to ``command_callbacks_``.
+  std::vector<PendingCallback> callbacks;
+  for (auto it = this->command_callbacks_.begin(); it != this->command_callbacks_.end();) {
+    if (it->id == pending.callback_id) {
+      callbacks.push_back(std::move(*it));
+      it = this->command_callbacks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto &entry : callbacks) {
+    if (entry.callback) {
+      entry.callback(success, latency_ms);
+    } else {
+      entry.query_callback(success, lines);
+    }
+  }
+}
+
+// Convenience wrappers for popular subscription targets.  They are exposed to
+// users through templated buttons in YAML.
+bool ESP32EVSEComponent::at_sub(const std::string &command, uint32_t period_ms) {
+  if (!this->is_valid_subscription_argument_(command)) {
+    ESP_LOGW(TAG,
+             "Rejected AT+SUB wrapper request with argument '%s'; only subscription targets are allowed",
+             command.c_str());
     return false;
-  PendingCommand pending;
-  pending.command.assign(command);
-  this->queue_pending_command_(pending);
+  }
+  ESP_LOGD(TAG, "Sending AT+SUB for command '%s' with period %" PRIu32 " ms", command.c_str(), period_ms);
+  CommandString cmd;
+  cmd.assign("AT+SUB=");
+  cmd.append(command);
+  cmd.append_char(',');
+  cmd.append_unsigned(period_ms);
+  return this->send_command_(cmd, CommandPriority::USER);
+}
+
+bool ESP32EVSEComponent::at_unsub(const std::string &command) {
+  if (command.empty()) {
+    ESP_LOGD(TAG, "Sending AT+UNSUB with empty command parameter");
+    CommandString cmd;
+    cmd.assign("AT+UNSUB=\"\"");
+    return this->send_command_(cmd, CommandPriority::USER);
+  }
+
+  if (!this->is_valid_subscription_argument_(command)) {
+    ESP_LOGW(TAG,
+             "Rejected AT+UNSUB wrapper request with argument '%s'; only subscription targets are allowed",
+             command.c_str());
+    return false;
+  }
+
+  ESP_LOGD(TAG, "Sending AT+UNSUB for command '%s'", command.c_str());
+  CommandString cmd;
+  cmd.assign("AT+UNSUB=");
+  cmd.append(command);
+  return this->send_command_(cmd, CommandPriority::USER);
+}
+
+bool ESP32EVSEComponent::request_subscription(const std::string &target, const std::string &owner,
+                                              uint32_t period_ms) {
+  ResponseKey key = lookup_subscription_target(target);
+  if (key == ResponseKey::UNKNOWN) {
+    ESP_LOGW(TAG, "Rejected subscription request for unknown target '%s'", target.c_str());
+    return false;
+  }
+  const uint8_t index = static_cast<uint8_t>(key);
+  auto it = std::find_if(this->subscription_requests_.begin(), this->subscription_requests_.end(),
+                         [&](const SubscriptionRequest &request) {
+                           return request.target == index && request.owner == owner;
+                         });
+  if (period_ms == 0) {
+    if (it == this->subscription_requests_.end())
+      return true;
+    this->subscription_requests_.erase(it);
+  } else if (it != this->subscription_requests_.end()) {
+    if (it->period_ms == period_ms)
+      return true;
+    it->period_ms = period_ms;
+  } else {
+    this->subscription_requests_.push_back(SubscriptionRequest{index, owner, period_ms});
+  }
+  if (period_ms == 0) {
+    ESP_LOGD(TAG, "Subscription +%.*s released by %s", static_cast<int>(kResponseKeyNames[index].size()),
+             kResponseKeyNames[index].data(), owner.c_str());
+  } else {
+    ESP_LOGD(TAG, "Subscription +%.*s requested by %s every %" PRIu32 " ms",
+             static_cast<int>(kResponseKeyNames[index].size()), kResponseKeyNames[index].data(), owner.c_str(),
+             period_ms);
+  }
+  this->subscriptions_dirty_ = true;
+  this->sync_subscriptions_();
   return true;
 }
 
-bool ESP32EVSEComponent::send_command_(const CommandString &command) {
-  if (command.size() == 0)
+bool ESP32EVSEComponent::release_all_subscriptions() {
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+  // Load management cannot work without its current stream; it is requested
+  // again right after the EVSE has been cleared.
+  this->subscription_requests_.erase(
+      std::remove_if(this->subscription_requests_.begin(), this->subscription_requests_.end(),
+                     [](const SubscriptionRequest &request) { return request.owner != kLoadManagementOwner; }),
+      this->subscription_requests_.end());
+#else
+  this->subscription_requests_.clear();
+#endif
+  this->subscriptions_dirty_ = false;
+  if (!this->queue_subscription_command_(SUBSCRIPTION_TARGET_ALL, 0)) {
+    this->subscriptions_applied_.fill(SUBSCRIPTION_UNKNOWN);
+    this->subscriptions_dirty_ = true;
     return false;
-  PendingCommand pending;
-  pending.command = command;
-  this->queue_pending_command_(pending);
+  }
+  this->subscriptions_applied_.fill(0);
+  if (!this->subscription_requests_.empty()) {
+    this->subscriptions_dirty_ = true;
+    this->sync_subscriptions_();
+  }
   return true;
 }
 
-void ESP32EVSEComponent::queue_pending_command_(const PendingCommand &pending) {
-  ESP_LOGV(TAG, "Queueing command: %s", pending.command.c_str());
-  // Track each command so we only send one request at a time and can associate
-  // the eventual OK/ERROR response with the original metadata.
-  const bool prioritize_interactive = pending.type != PendingCommand::Type::GENERIC;
+// The EVSE gets the shortest period any owner asked for; ``0`` when nobody
+// wants the target.
+uint32_t ESP32EVSEComponent::desired_subscription_period_(uint8_t target) const {
+  uint32_t period = 0;
+  for (const auto &request : this->subscription_requests_) {
+    if (request.target == target && (period == 0 || request.period_ms < period))
+      period = request.period_ms;
+  }
+  return period;
+}
+
+// Bring the EVSE in line with the requested table, sending only the targets
+// whose period changed.  Anything that does not fit the queue stays dirty and
+// is retried on the next ``update()``.
+void ESP32EVSEComponent::sync_subscriptions_() {
+  static_assert(static_cast<size_t>(ResponseKey::UNKNOWN) == SUBSCRIPTION_TARGET_COUNT,
+                "subscription targets must cover every response key");
+  if (!this->subscriptions_started_ || !this->subscriptions_dirty_)
+    return;
+  this->subscriptions_dirty_ = false;
+
+  // Nothing is known about the EVSE side yet: clear it with one command rather
+  // than unsubscribing every target individually.
+  const bool all_unknown = std::all_of(this->subscriptions_applied_.begin(), this->subscriptions_applied_.end(),
+                                       [](uint32_t applied) { return applied == SUBSCRIPTION_UNKNOWN; });
+  if (all_unknown) {
+    if (!this->queue_subscription_command_(SUBSCRIPTION_TARGET_ALL, 0)) {
+      this->subscriptions_dirty_ = true;
+      return;
+    }
+    this->subscriptions_applied_.fill(0);
+  }
 
-  bool enqueued = false;
-  if (!prioritize_interactive || this->pending_commands_.empty()) {
-    enqueued = this->pending_commands_.push_back(pending);
+  for (uint8_t target = 0; target < this->subscriptions_applied_.size(); ++target) {
+    const uint32_t desired = this->desired_subscription_period_(target);
+    if (this->subscriptions_applied_[target] == desired)
+      continue;
+    if (!this->queue_subscription_command_(target, desired)) {
+      this->subscriptions_dirty_ = true;
+      return;
+    }
+    this->subscriptions_applied_[target] = desired;
+  }
+}
+
+bool ESP32EVSEComponent::queue_subscription_command_(uint8_t target, uint32_t period_ms) {
+  PendingCommand pending;
+  pending.type = PendingCommand::Type::SUBSCRIPTION;
+  pending.subscription_target = target;
+  if (target == SUBSCRIPTION_TARGET_ALL) {
+    pending.command.assign("AT+UNSUB=\"\"");
   } else {
-    size_t insert_index = 0;
-    if (this->pending_commands_.front().sent)
-      insert_index = 1;  // Keep the command currently waiting for an ACK at the front.
+    const std::string_view name = kResponseKeyNames[target];
+    pending.command.assign(period_ms == 0 ? "AT+UNSUB=\"+" : "AT+SUB=\"+");
+    // The key names are string literals, so ``data()`` is NUL-terminated.
+    pending.command.append(name.data());
+    pending.command.append_char('"');
+    if (period_ms != 0) {
+      pending.command.append_char(',');
+      pending.command.append_unsigned(period_ms);
+    }
+  }
+  return this->queue_pending_command_(pending);
+}
 
-    for (; insert_index < this->pending_commands_.size(); ++insert_index) {
-      const auto &candidate = this->pending_commands_[insert_index];
-      if (!candidate.sent && candidate.type == PendingCommand::Type::GENERIC)
-        break;
+// Validate that a subscription string only contains characters supported by the
+// EVSE firmware (alphanumeric, plus, underscore, and quotes).
+bool ESP32EVSEComponent::is_valid_subscription_argument_(const std::string &argument) const {
+  if (argument.empty()) {
+    return false;
+  }
+  for (size_t i = 0; i + 2 < argument.size(); ++i) {
+    char c0 = argument[i];
+    char c1 = argument[i + 1];
+    char c2 = argument[i + 2];
+    if ((c0 == 'A' || c0 == 'a') && (c1 == 'T' || c1 == 't') && c2 == '+') {
+      return false;
     }
-    enqueued = this->pending_commands_.insert(insert_index, pending);
   }
-  if (!enqueued) {
-    ESP_LOGW(TAG, "Pending command queue full, dropping '%s'", pending.command.c_str());
-    return;
+  return true;
+}
+
+bool ESP32EVSEComponent::send_reset_command() { return this->send_command_("AT+RST", CommandPriority::USER); }
+
+bool ESP32EVSEComponent::send_authorize_command() { return this->send_command_("AT+AUTH", CommandPriority::USER); }
+
+bool ESP32EVSEComponent::send_start_ap_command() {
+  return this->send_command_("AT+WIFIAPCFG=1", CommandPriority::USER);
+}
+
+bool ESP32EVSEComponent::query(const char *command, QueryCallback callback) {
+  const size_t length = command == nullptr ? 0 : strlen(command);
+  if (length < 2 || length > CommandString::MAX_LENGTH || strncmp(command, "AT", 2) != 0 ||
+      strpbrk(command, "\r\n") != nullptr) {
+    ESP_LOGW(TAG, "Refusing raw command '%s'", command == nullptr ? "" : command);
+    if (callback)
+      callback(false, {});
+    return false;
   }
-  this->process_next_command_();
+  PendingCommand pending;
+  pending.type = PendingCommand::Type::RAW;
+  pending.command.assign(command);
+  return this->queue_with_callback_(pending, nullptr, std::move(callback));
+}
+
+bool ESP32EVSEComponent::capture_raw_line_(std::string_view line) {
+  if (this->pending_commands_.empty() || line.empty() || line[0] != '+')
+    return false;
+  const PendingCommand &head = this->pending_commands_.front();
+  if (!head.sent || head.type != PendingCommand::Type::RAW)
+    return false;
+  const std::string_view command(head.command.c_str(), head.command.size());
+  if (!answers_command(command, line))
+    return false;
+  // A query is answered by one line.  Further lines with its key before the
+  // ``OK`` are subscription pushes and only go to the entities.
+  if (is_query_command(command) && !this->raw_response_.empty())
+    return false;
+  if (this->raw_response_.size() + line.size() + 1 > kMaxRawResponseLength) {
+    ESP_LOGW(TAG, "Response to '%s' too long, dropping '%.*s'", head.command.c_str(), static_cast<int>(line.size()),
+             line.data());
+    return true;
+  }
+  if (!this->raw_response_.empty())
+    this->raw_response_.push_back('\n');
+  this->raw_response_.append(line.data(), line.size());
+  return true;
 }
 
-bool ESP32EVSEComponent::is_front_sent_write_(PendingCommand::Type type,
-                                              ESP32EVSEChargingCurrentNumber *number) const {
-  if (this->pending_commands_.empty())
+bool ESP32EVSEComponent::send_command_(const char *command, CommandPriority priority) {
+  if (command == nullptr || command[0] == '\0')
     return false;
-  const auto &front = this->pending_commands_.front();
-  if (!front.sent)
+  PendingCommand pending;
+  pending.priority = priority;
+  pending.command.assign(command);
+  return this->queue_pending_command_(pending);
+}
+
+bool ESP32EVSEComponent::send_command_(const CommandString &command, CommandPriority priority) {
+  if (command.size() == 0)
     return false;
-  if (front.type != type)
+  PendingCommand pending;
+  pending.priority = priority;
+  pending.command = command;
+  return this->queue_pending_command_(pending);
+}
+
+// Fault flags are polled ahead of everything else; the other control and
+// telemetry slots come before the rarely changing settings and identity.
+bool ESP32EVSEComponent::send_slot_query_(const SlotQuery &query) {
+  CommandPriority priority = CommandPriority::BACKGROUND;
+  if (query.slot == FreshnessSlot::ERROR_FLAGS) {
+    priority = CommandPriority::SAFETY;
+  } else if (query.stage == BootStage::CONTROL || query.stage == BootStage::TELEMETRY) {
+    priority = CommandPriority::CONTROL;
+  }
+  return this->send_command_(query.command, priority);
+}
+
+bool ESP32EVSEComponent::queue_pending_command_(const PendingCommand &pending) {
+  ESP_LOGV(TAG, "Queueing command: %s", pending.command.c_str());
+  if (this->link_state_ == LinkState::DOWN && pending.type != PendingCommand::Type::PROBE) {
+    ESP_LOGV(TAG, "Link down, not queueing '%s'", pending.command.c_str());
     return false;
-  if (type == PendingCommand::Type::NUMBER_WRITE && front.number != number)
+  }
+  if (this->coalesce_pending_command_(pending))
+    return true;
+
+  // Track each command so at most ``command_window_`` requests are in flight
+  // and the eventual OK/ERROR responses can be matched, in order, with the
+  // original metadata.
+  PendingCommand queued = pending;
+  queued.priority = command_priority_(pending);
+  queued.queued_time = millis();
+
+  // Walk back from the tail past the commands this one may overtake.  Commands
+  // already sent stay ahead because their ACKs will arrive first.  The tail
+  // usually holds the least urgent class, so a poll burst appends in O(1).
+  size_t insert_index = this->pending_commands_.size();
+  while (insert_index > 0) {
+    const auto &candidate = this->pending_commands_[insert_index - 1];
+    if (candidate.sent || effective_priority_(candidate, queued.queued_time) <= queued.priority)
+      break;
+    --insert_index;
+  }
+  if (!this->pending_commands_.insert(insert_index, queued)) {
+    ++this->dropped_commands_;
+    ESP_LOGW(TAG, "Pending command queue full, dropping '%s' (%" PRIu32 " dropped so far)", pending.command.c_str(),
+             this->dropped_commands_);
     return false;
-  // Only treat the front command as a pending write if we've already pushed it
-  // to the EVSE and the metadata matches the entity currently updating.
+  }
+  this->queue_high_water_mark_ = std::max(this->queue_high_water_mark_, this->pending_commands_.size());
+  this->process_next_command_();
   return true;
 }
 
+// Fold ``pending`` into a command that is queued but not yet sent.  A repeated
+// query is simply dropped, while a newer write to the same switch or number
+// replaces the stale value in place so it keeps its position in the queue.
+// Returns ``true`` when the command was absorbed and must not be enqueued.
+bool ESP32EVSEComponent::coalesce_pending_command_(const PendingCommand &pending) {
+  const bool is_query = pending.type == PendingCommand::Type::GENERIC && pending.command.is_query();
+  // Raw commands each wait for their own answer.
+  if ((!is_query && pending.type == PendingCommand::Type::GENERIC) || pending.type == PendingCommand::Type::RAW)
+    return false;
+
+  for (size_t i = 0; i < this->pending_commands_.size(); ++i) {
+    auto &queued = this->pending_commands_[i];
+    if (queued.sent || queued.type != pending.type)
+      continue;
+    if (is_query) {
+      if (!queued.command.equals(pending.command))
+        continue;
+      ESP_LOGV(TAG, "Query '%s' already queued", pending.command.c_str());
+    } else {
+      if (pending.type == PendingCommand::Type::NUMBER_WRITE && queued.number != pending.number)
+        continue;
+      if (pending.type == PendingCommand::Type::SUBSCRIPTION &&
+          queued.subscription_target != pending.subscription_target)
+        continue;
+      ESP_LOGV(TAG, "Superseding queued '%s' with '%s'", queued.command.c_str(), pending.command.c_str());
+      queued.command = pending.command;
+      queued.bool_value = pending.bool_value;
+      queued.scaled_value = pending.scaled_value;
+      // The superseded write's callbacks now wait for the newer value.
+      if (pending.callback_id != 0) {
+        if (queued.callback_id == 0) {
+          queued.callback_id = pending.callback_id;
+        } else {
+          for (auto &entry : this->command_callbacks_) {
+            if (entry.id == pending.callback_id)
+              entry.id = queued.callback_id;
+          }
+        }
+      }
+    }
+    ++this->merged_commands_;
+    return true;
+  }
+  return false;
+}
+
+bool ESP32EVSEComponent::is_write_in_flight_(PendingCommand::Type type,
+                                             ESP32EVSEChargingCurrentNumber *number) const {
+  // Sent commands form the head of the queue; only those are pushed to the
+  // EVSE already, so only they can cause the echo we want to suppress.
+  for (size_t i = 0; i < this->pending_commands_.size(); ++i) {
+    const auto &command = this->pending_commands_[i];
+    if (!command.sent)
+      break;
+    if (command.type != type)
+      continue;
+    if (type == PendingCommand::Type::NUMBER_WRITE && command.number != number)
+      continue;
+    return true;
+  }
+  return false;
+}
+
+// Like ``is_write_in_flight_`` but also counts writes that are not sent yet.
+bool ESP32EVSEComponent::is_write_queued_(PendingCommand::Type type, ESP32EVSEChargingCurrentNumber *number) const {
+  for (size_t i = 0; i < this->pending_commands_.size(); ++i) {
+    const auto &command = this->pending_commands_[i];
+    if (command.type == type && (type != PendingCommand::Type::NUMBER_WRITE || command.number == number))
+      return true;
+  }
+  return false;
+}
+
 // Parse a single line returned by the EVSE and dispatch to the appropriate
 // update handler.  The protocol is a mix of ``+KEY=VALUE`` lines and asynchronous
 // ``OK``/``ERROR`` acknowledgements.
-void ESP32EVSEComponent::process_line_(const std::string &line) {
-  ESP_LOGV(TAG, "Received line: %s", line.c_str());
+void ESP32EVSEComponent::process_line_(std::string_view line) {
+  ESP_LOGV(TAG, "Received line: %.*s", static_cast<int>(line.size()), line.data());
+  // Any traffic at all (a subscription push, ``RDY``) proves the EVSE is back.
+  if (this->link_state_ == LinkState::DOWN) {
+    this->consecutive_timeouts_ = 0;
+    this->set_link_state_(LinkState::UP);
+  }
+  if (this->resyncing_ && !this->pending_commands_.empty()) {
+    const PendingCommand &front = this->pending_commands_.front();
+    if (front.sent && front.type == PendingCommand::Type::PROBE &&
+        answers_command(std::string_view(front.command.c_str(), front.command.size()), line))
+      this->resync_line_seen_ = true;
+  }
   if (line == "OK") {
     this->handle_ack_(true, false);
     return;
@@ -815,353 +2288,640 @@ void ESP32EVSEComponent::process_line_(const std::string &line) {
   }
   if (line == "RDY") {
     ESP_LOGI(TAG, "ESP32-EVSE ready to accept commands");
+    // The EVSE rebooted: every cached value, including the once-per-boot
+    // identity data, has to be read again on the next poll.
+    this->last_response_millis_.fill(0);
+    // Subscriptions do not survive the reboot either; push the whole table.
+    this->subscriptions_applied_.fill(0);
+    this->subscriptions_dirty_ = true;
+    this->sync_subscriptions_();
     this->ready_trigger_.trigger();
     return;
   }
-  if (const char *value = value_after_prefix(line, "+STATE")) {
-    int state_value = atoi(value);
-    this->update_state_(state_value);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+ENABLE")) {
-    int enable_value = atoi(value);
-    this->update_enable_(enable_value == 1);
+  const bool captured = this->capture_raw_line_(line);
+  const char *value = nullptr;
+  const ResponseKey key = lookup_response_key(line, &value);
+  if (key == ResponseKey::UNKNOWN) {
+    if (!captured)
+      ESP_LOGD(TAG, "Unhandled line: %.*s", static_cast<int>(line.size()), line.data());
     return;
   }
-  if (const char *value = value_after_prefix(line, "+TEMP")) {
-    int count = 0;
-    int32_t high = 0;
-    int32_t low = 0;
-    if (sscanf(value, "%d,%" PRIi32 ",%" PRIi32, &count, &high, &low) == 3) {
-      this->update_temperature_(count, high, low);
+  const std::string_view payload(value, line.data() + line.size() - value);
+  FieldReader fields(payload);
+  FieldStatus status = FieldStatus::OK;
+  switch (key) {
+    case ResponseKey::STATE: {
+      uint8_t state_value = 0;
+      if ((status = fields.next_integer(state_value)) == FieldStatus::OK)
+        this->update_state_(state_value);
+      break;
     }
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+CHCUR")) {
-    int chcur_value = atoi(value);
-    if (chcur_value >= 0)
-      this->update_charging_current_(static_cast<uint16_t>(chcur_value));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+EMETERPOWER")) {
-    uint32_t power = static_cast<uint32_t>(strtoul(value, nullptr, 10));
-    this->update_emeter_power_(power);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+EMETERSESTIME")) {
-    uint32_t time = static_cast<uint32_t>(strtoul(value, nullptr, 10));
-    this->update_emeter_session_time_(time);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+EMETERCHTIME")) {
-    uint32_t time = static_cast<uint32_t>(strtoul(value, nullptr, 10));
-    this->update_emeter_charging_time_(time);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+UPTIME")) {
-    uint32_t seconds = static_cast<uint32_t>(strtoul(value, nullptr, 10));
-    this->update_uptime_(seconds);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+CHIP")) {
-    std::string_view chip_info = trim_view(value);
-    std::string_view chip_name = nth_trimmed_token(chip_info, 0);
-    if (chip_name.empty())
-      chip_name = chip_info;
-
-    std::string formatted(chip_name);
-    std::string_view chip_cores = nth_trimmed_token(chip_info, 1);
-    if (!chip_cores.empty()) {
-      int cores = 0;
-      auto parse_result = std::from_chars(chip_cores.data(), chip_cores.data() + chip_cores.size(), cores);
-      if (parse_result.ec != std::errc())
-        cores = 0;
-      if (cores > 0)
-        formatted += ", " + std::to_string(cores) + (cores == 1 ? " core" : " cores");
+    case ResponseKey::TEMP: {
+      int count = 0;
+      int32_t high = 0;
+      int32_t low = 0;
+      if ((status = fields.next_integer(count)) == FieldStatus::OK &&
+          (status = fields.next_integer(high)) == FieldStatus::OK &&
+          (status = fields.next_integer(low)) == FieldStatus::OK)
+        this->update_temperature_(count, high, low);
+      break;
     }
+    case ResponseKey::CHCUR: {
+      uint16_t chcur_value = 0;
+      if ((status = fields.next_integer(chcur_value)) == FieldStatus::OK)
+        this->update_charging_current_(chcur_value);
+      break;
+    }
+    case ResponseKey::EMETERPOWER: {
+      uint32_t power = 0;
+      if ((status = fields.next_integer(power)) == FieldStatus::OK)
+        this->update_emeter_power_(power);
+      break;
+    }
+    case ResponseKey::CHIP: {
+      std::string_view chip_info = trim_view(value);
+      std::string_view chip_name = nth_trimmed_token(chip_info, 0);
+      if (chip_name.empty())
+        chip_name = chip_info;
 
-    this->update_chip_(formatted);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+VER")) {
-    this->update_version_(trim_copy(value));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+IDFVER")) {
-    this->update_idf_version_(trim_copy(value));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+BUILDTIME")) {
-    this->update_build_time_(trim_copy(value));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+TIME")) {
-    uint32_t timestamp = static_cast<uint32_t>(strtoul(value, nullptr, 10));
-    this->update_device_time_(timestamp);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+WIFISTACFG")) {
-    std::string_view wifi_cfg = trim_view(value);
-    std::string_view ssid = nth_trimmed_token(wifi_cfg, 1);
-    if (ssid.empty())
-      ssid = "<hidden>";
-    this->update_wifi_sta_cfg_(std::string(ssid));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+WIFISTAIP")) {
-    this->update_wifi_sta_ip_(trim_copy(value));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+WIFISTAMAC")) {
-    this->update_wifi_sta_mac_(trim_copy(value));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+DEVNAME")) {
-    this->update_device_name_(trim_copy(value));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+AVAILABLE")) {
-    int available = atoi(value);
-    this->update_available_(available == 1);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+REQAUTH")) {
-    int req = atoi(value);
-    this->update_request_authorization_(req == 1);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+EMETERTHREEPHASE")) {
-    int enabled = atoi(value);
-    this->update_emeter_three_phase_(enabled == 1);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+HEAP")) {
-    const char *cursor = value;
-    char *endptr = nullptr;
-    bool has_used = false;
-    bool has_total = false;
-    uint32_t heap_used = 0;
-    uint32_t heap_total = 0;
-
-    unsigned long parsed = strtoul(cursor, &endptr, 10);
-    if (endptr != cursor) {
-      heap_used = static_cast<uint32_t>(parsed);
-      has_used = true;
-      cursor = endptr;
+      int cores = 0;
+      if (parse_integer(nth_trimmed_token(chip_info, 1), cores) != FieldStatus::OK || cores <= 0) {
+        this->update_chip_(chip_name);
+        return;
+      }
 
-      while (*cursor != '\0' && isspace(static_cast<unsigned char>(*cursor)))
-        ++cursor;
-      if (*cursor == ',') {
-        ++cursor;
-        while (*cursor != '\0' && isspace(static_cast<unsigned char>(*cursor)))
-          ++cursor;
-        parsed = strtoul(cursor, &endptr, 10);
-        if (endptr != cursor) {
-          heap_total = static_cast<uint32_t>(parsed);
-          has_total = true;
-        }
+      char formatted[MAX_LINE_LENGTH + 16];
+      int written = snprintf(formatted, sizeof(formatted), "%.*s, %d %s", static_cast<int>(chip_name.size()),
+                             chip_name.data(), cores, cores == 1 ? "core" : "cores");
+      if (written < 0)
+        return;
+      this->update_chip_(std::string_view(formatted, std::min(static_cast<size_t>(written), sizeof(formatted) - 1)));
+      return;
+    }
+    case ResponseKey::VER: {
+      this->update_version_(trim_view(value));
+      return;
+    }
+    case ResponseKey::BUILDTIME: {
+      this->update_build_time_(trim_view(value));
+      return;
+    }
+    case ResponseKey::TIME: {
+      uint32_t timestamp = 0;
+      if ((status = fields.next_integer(timestamp)) == FieldStatus::OK)
+        this->update_device_time_(timestamp);
+      break;
+    }
+    case ResponseKey::WIFISTACFG: {
+      std::string_view wifi_cfg = trim_view(value);
+      std::string_view ssid = nth_trimmed_token(wifi_cfg, 1);
+      if (ssid.empty())
+        ssid = "<hidden>";
+      this->update_wifi_sta_cfg_(ssid);
+      return;
+    }
+    case ResponseKey::HEAP: {
+      // ``used[,total]``; either half is forwarded when it parses.
+      uint32_t heap_used = 0;
+      uint32_t heap_total = 0;
+      const bool has_used = (status = fields.next_integer(heap_used)) == FieldStatus::OK;
+      const bool has_total = fields.next_integer(heap_total) == FieldStatus::OK;
+      if (has_used || has_total) {
+        status = FieldStatus::OK;
+        this->update_heap_(has_used ? std::optional<uint32_t>(heap_used) : std::nullopt,
+                           has_total ? std::optional<uint32_t>(heap_total) : std::nullopt);
       }
+      break;
     }
-
-    if (has_used || has_total) {
-      this->update_heap_(has_used ? std::optional<uint32_t>(heap_used) : std::nullopt,
-                         has_total ? std::optional<uint32_t>(heap_total) : std::nullopt);
-    } else {
-      ESP_LOGW(TAG, "Unable to parse heap values from '%s'", value);
+    case ResponseKey::EMETERCONSUM: {
+      int64_t consum = 0;
+      if ((status = fields.next_fixed(0, consum)) == FieldStatus::OK)
+        this->update_energy_consumption_(consum);
+      break;
     }
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+EMETERCONSUM")) {
-    float consum = strtof(value, nullptr);
-    this->update_energy_consumption_(consum);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+EMETERTOTCONSUM")) {
-    float consum = parse_last_float(value);
-    if (std::isnan(consum)) {
-      ESP_LOGW(TAG, "Unable to parse total energy consumption from '%s'", value);
-    } else {
-      this->update_total_energy_consumption_(consum);
+    case ResponseKey::EMETERTOTCONSUM: {
+      int64_t consum = 0;
+      if ((status = fields.last().next_fixed(0, consum)) == FieldStatus::OK)
+        this->update_total_energy_consumption_(consum);
+      break;
     }
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+EMETERVOLTAGE")) {
-    float l1 = NAN;
-    float l2 = NAN;
-    float l3 = NAN;
-    if (sscanf(value, "%f,%f,%f", &l1, &l2, &l3) == 3) {
-      // The EVSE reports the three phase voltages in a single response.  That
-      // holds both for polled replies (``AT+EMETERVOLTAGE?``) and for
-      // subscription streams started with ``AT+SUB`` where the controller
-      // pushes updates on its own, so all three entities are published
-      // back-to-back from the same UART line.
-      this->update_voltages_(l1, l2, l3);
+    case ResponseKey::EMETERVOLTAGE: {
+      int64_t l1 = 0;
+      int64_t l2 = 0;
+      int64_t l3 = 0;
+      if ((status = fields.next_fixed(0, l1)) == FieldStatus::OK &&
+          (status = fields.next_fixed(0, l2)) == FieldStatus::OK &&
+          (status = fields.next_fixed(0, l3)) == FieldStatus::OK) {
+        // The EVSE reports the three phase voltages in a single response.  That
+        // holds both for polled replies (``AT+EMETERVOLTAGE?``) and for
+        // subscription streams started with ``AT+SUB`` where the controller
+        // pushes updates on its own, so all three entities are published
+        // back-to-back from the same UART line.
+        this->update_voltages_(l1, l2, l3);
+      }
+      break;
     }
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+EMETERCURRENT")) {
-    float l1 = NAN;
-    float l2 = NAN;
-    float l3 = NAN;
-    if (sscanf(value, "%f,%f,%f", &l1, &l2, &l3) == 3) {
-      // Similarly for the phase currents: whether they arrive as a response to
-      // ``AT+EMETERCURRENT?`` or as part of a subscription stream, the EVSE
-      // delivers the three measurements together, so their publish timestamps
-      // only differ by the bookkeeping time inside this callback.
-      this->update_currents_(l1, l2, l3);
+    case ResponseKey::EMETERCURRENT: {
+      int64_t l1 = 0;
+      int64_t l2 = 0;
+      int64_t l3 = 0;
+      if ((status = fields.next_fixed(0, l1)) == FieldStatus::OK &&
+          (status = fields.next_fixed(0, l2)) == FieldStatus::OK &&
+          (status = fields.next_fixed(0, l3)) == FieldStatus::OK) {
+        // Similarly for the phase currents: whether they arrive as a response to
+        // ``AT+EMETERCURRENT?`` or as part of a subscription stream, the EVSE
+        // delivers the three measurements together, so their publish timestamps
+        // only differ by the bookkeeping time inside this callback.
+        this->update_currents_(l1, l2, l3);
+      }
+      break;
     }
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+WIFISTACONN")) {
-    int connected = 0;
-    int rssi = std::numeric_limits<int>::min();
-    int parsed = sscanf(value, "%d,%d", &connected, &rssi);
-    if (parsed >= 1) {
-      if (parsed < 2) {
-        rssi = std::numeric_limits<int>::min();
+    case ResponseKey::WIFISTACONN: {
+      // ``connected[,rssi]``; the RSSI is absent while disconnected.
+      int connected = 0;
+      int rssi = std::numeric_limits<int>::min();
+      if ((status = fields.next_integer(connected)) == FieldStatus::OK) {
+        if (fields.next_integer(rssi) != FieldStatus::OK)
+          rssi = std::numeric_limits<int>::min();
+        this->update_wifi_status_(connected == 1, rssi);
       }
-      this->update_wifi_status_(connected == 1, rssi);
+      break;
+    }
+    case ResponseKey::MAXCHCUR: {
+      uint16_t val = 0;
+      if ((status = fields.next_integer(val)) == FieldStatus::OK)
+        this->update_maximum_charging_current_(val);
+      break;
+    }
+    case ResponseKey::ERROR: {
+      uint32_t mask = 0;
+      if ((status = fields.next_integer(mask)) == FieldStatus::OK)
+        this->update_error_flags_(mask);
+      break;
+    }
+    default: {
+      // Plain slots: the format and the entity come from ``SLOT_QUERIES``.
+      static constexpr auto kResponseSlots = build_response_slots(SLOT_QUERIES);
+      const uint8_t slot = kResponseSlots[static_cast<size_t>(key)];
+      if (slot == kNoResponseSlot)
+        break;
+      const SlotQuery &query = SLOT_QUERIES[slot];
+      switch (query.format) {
+        case SlotFormat::INTEGER: {
+          uint32_t raw = 0;
+          if ((status = fields.next_integer(raw)) == FieldStatus::OK)
+            this->publish_slot_value_(query, raw);
+          break;
+        }
+        case SlotFormat::FIXED: {
+          int64_t raw = 0;
+          if ((status = fields.next_fixed(0, raw)) == FieldStatus::OK)
+            this->publish_slot_value_(query, raw);
+          break;
+        }
+        case SlotFormat::FLAG: {
+          int raw = 0;
+          if ((status = fields.next_integer(raw)) == FieldStatus::OK)
+            this->publish_slot_value_(query, raw == 1);
+          break;
+        }
+        case SlotFormat::TEXT:
+          this->publish_slot_text_(query, trim_view(value));
+          break;
+        case SlotFormat::CUSTOM:
+          ESP_LOGW(TAG, "No handler for '%.*s'", static_cast<int>(line.size()), line.data());
+          break;
+      }
+      break;
     }
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+DEFCHCUR")) {
-    int val = atoi(value);
-    this->update_default_charging_current_(static_cast<uint16_t>(val));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+MAXCHCUR")) {
-    int val = atoi(value);
-    this->update_maximum_charging_current_(static_cast<uint16_t>(val));
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+CONSUMLIM")) {
-    float val = strtof(value, nullptr);
-    this->update_consumption_limit_(val);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+DEFCONSUMLIM")) {
-    float val = strtof(value, nullptr);
-    this->update_default_consumption_limit_(val);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+CHTIMELIM")) {
-    uint32_t val = static_cast<uint32_t>(strtoul(value, nullptr, 10));
-    this->update_charging_time_limit_(val);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+DEFCHTIMELIM")) {
-    uint32_t val = static_cast<uint32_t>(strtoul(value, nullptr, 10));
-    this->update_default_charging_time_limit_(val);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+UNDERPOWERLIM")) {
-    float val = strtof(value, nullptr);
-    this->update_under_power_limit_(val);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+DEFUNDERPOWERLIM")) {
-    float val = strtof(value, nullptr);
-    this->update_default_under_power_limit_(val);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+LIMREACH")) {
-    int val = atoi(value);
-    this->update_charging_limit_reached_(val == 1);
-    return;
-  }
-  if (const char *value = value_after_prefix(line, "+ERROR")) {
-    uint32_t mask = static_cast<uint32_t>(strtoul(value, nullptr, 0));
-    this->update_error_flags_(mask);
-    return;
   }
-  if (const char *value = value_after_prefix(line, "+PENDAUTH")) {
-    int val = atoi(value);
-    this->update_pending_authorization_(val == 1);
-    return;
+  if (status != FieldStatus::OK) {
+    // A device sending garbage would otherwise flood the log with one warning
+    // per line.
+    const uint64_t bit = uint64_t{1} << static_cast<uint8_t>(key);
+    if ((this->malformed_keys_warned_ & bit) == 0) {
+      this->malformed_keys_warned_ |= bit;
+      ESP_LOGW(TAG, "Unable to parse '%.*s': %s", static_cast<int>(line.size()), line.data(),
+               field_status_str(status));
+    } else {
+      ++this->malformed_lines_unreported_;
+      ESP_LOGV(TAG, "Unable to parse '%.*s': %s", static_cast<int>(line.size()), line.data(),
+               field_status_str(status));
+    }
   }
+}
 
-  ESP_LOGD(TAG, "Unhandled line: %s", line.c_str());
+void ESP32EVSEComponent::report_malformed_lines_() {
+  if (this->malformed_lines_unreported_ > 0) {
+    ESP_LOGW(TAG, "Malformed lines since the last update: %" PRIu32 " more", this->malformed_lines_unreported_);
+    this->malformed_lines_unreported_ = 0;
+  }
+  this->malformed_keys_warned_ = 0;
 }
 
 // Called after receiving an ``OK`` or ``ERROR`` response for the oldest pending
 // command.
 void ESP32EVSEComponent::handle_ack_(bool success, bool timed_out) {
-  if (this->pending_commands_.empty()) {
-    ESP_LOGW(TAG, "Received %s without pending command", success ? "OK" : "ERROR");
+  if (this->pending_commands_.empty() || !this->pending_commands_.front().sent) {
+    if (this->resyncing_) {
+      ESP_LOGD(TAG, "Dropping late %s after a timeout", success ? "OK" : "ERROR");
+    } else {
+      ESP_LOGW(TAG, "Received %s without pending command", success ? "OK" : "ERROR");
+    }
+    return;
+  }
+  if (this->resyncing_ && !timed_out && !this->resync_line_seen_) {
+    ESP_LOGD(TAG, "Dropping late %s after a timeout", success ? "OK" : "ERROR");
     return;
   }
   PendingCommand pending = this->pending_commands_.front();
   this->pending_commands_.pop_front();
+  if (pending.type == PendingCommand::Type::PROBE && !timed_out) {
+    this->resyncing_ = false;
+    this->abandoned_probes_ = 0;
+  }
   ESP_LOGV(TAG, "Command '%s' completed with %s", pending.command.c_str(), success ? "OK" : "ERROR");
-  if (!timed_out && this->timeout_fault_binary_sensor_ != nullptr) {
-    this->timeout_fault_binary_sensor_->publish_state(false);
+  auto &histogram = this->round_trip_histograms_[static_cast<size_t>(classify_command_(pending))];
+  if (timed_out) {
+    ++histogram.timeouts;
+    if (this->consecutive_timeouts_ < kLinkDownAfterTimeouts)
+      ++this->consecutive_timeouts_;
+    this->set_link_state_(this->consecutive_timeouts_ >= kLinkDownAfterTimeouts ? LinkState::DOWN
+                                                                                : LinkState::DEGRADED);
+    this->serial_acks_remaining_ = kSerialAcksAfterTimeout;
+  } else {
+    this->publish_binary_sensor_(EntityId::TIMEOUT_FAULT, false);
+    const uint32_t rtt = millis() - pending.start_time;
+    histogram.record(rtt);
+    this->record_round_trip_(rtt);
+    this->consecutive_timeouts_ = 0;
+    if (this->serial_acks_remaining_ > 0)
+      --this->serial_acks_remaining_;
+    this->set_link_state_(LinkState::UP);
+  }
+  this->complete_command_(pending, success);
+  if (timed_out) {
+    this->note_abandoned_(pending);
+    // Replies to the commands sent after it can no longer be told apart from
+    // its own; fail them too and let the probe realign the stream.
+    while (!this->pending_commands_.empty() && this->pending_commands_.front().sent) {
+      const PendingCommand abandoned = this->pending_commands_.front();
+      this->pending_commands_.pop_front();
+      ESP_LOGD(TAG, "Abandoning '%s' sent after a timed out command", abandoned.command.c_str());
+      this->note_abandoned_(abandoned);
+      this->complete_command_(abandoned, false);
+    }
   }
+  if (this->link_state_ == LinkState::DOWN)
+    this->fail_pending_commands_();
+  this->process_next_command_();
+}
+
+// Publish the outcome of a finished command to the entity that issued it.
+void ESP32EVSEComponent::complete_command_(const PendingCommand &pending, bool success) {
   switch (pending.type) {
     case PendingCommand::Type::ENABLE_WRITE:
-      if (this->enable_switch_ != nullptr) {
-        if (success) {
-          this->enable_switch_->publish_state(pending.bool_value);
-        } else {
-          this->enable_switch_->publish_state(!pending.bool_value);
-        }
+    case PendingCommand::Type::AVAILABLE_WRITE:
+    case PendingCommand::Type::REQUEST_AUTHORIZATION_WRITE:
+    case PendingCommand::Type::EMETER_THREE_PHASE_WRITE: {
+      const SwitchWrite *write = switch_write_(pending.type);
+      const EntityId id = write->entity;
+      ESP32EVSEOptimisticEntity *entity = this->switch_state_(id);
+      if (entity == nullptr || !this->settle_write_(entity, pending, success, pending.bool_value ? 1.0f : 0.0f))
+        break;
+      if (success) {
+        this->publish_switch_(id, pending.bool_value, true);
+      } else if (pending.type == PendingCommand::Type::ENABLE_WRITE) {
+        if (!this->roll_back_switch_(id))
+          this->publish_switch_(id, !pending.bool_value, true);
+      } else {
+        this->roll_back_switch_(id);
+        this->request_slot_update(write->slot);
       }
       break;
-    case PendingCommand::Type::AVAILABLE_WRITE:
-      if (this->available_switch_ != nullptr) {
+    }
+    case PendingCommand::Type::NUMBER_WRITE:
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+      if (pending.number != nullptr && pending.number == this->number_entity_(EntityId::CHARGING_CURRENT) &&
+          this->load_management_write_sample_ms_ != 0) {
         if (success) {
-          this->available_switch_->publish_state(pending.bool_value);
+          this->load_management_reaction_ms_ = millis() - this->load_management_write_sample_ms_;
+          ESP_LOGD(TAG, "Load management reaction: %" PRIu32 " ms from grid sample to OK",
+                   this->load_management_reaction_ms_);
         } else {
-          this->request_available_update();
+          // Let a sample try again once ``min_change_interval`` has passed.
+          this->charging_current_tenths_ = -1;
+          this->load_management_write_failed_ = true;
+          this->load_management_failed_ms_ = millis();
         }
+        this->load_management_write_sample_ms_ = 0;
       }
-      break;
-    case PendingCommand::Type::REQUEST_AUTHORIZATION_WRITE:
-      if (this->request_authorization_switch_ != nullptr) {
+#endif
+      if (pending.number != nullptr &&
+          this->settle_write_(pending.number, pending, success,
+                              this->scaled_number_value_(pending.number, pending.scaled_value))) {
         if (success) {
-          this->request_authorization_switch_->publish_state(pending.bool_value);
+          this->publish_scaled_number_(pending.number, pending.scaled_value, true);
         } else {
-          this->request_request_authorization_update();
+          const float confirmed = pending.number->get_confirmed_value();
+          if (pending.number->is_optimistic() && !std::isnan(confirmed) &&
+              this->should_publish_(this->number_id_(pending.number), confirmed, true))
+            pending.number->publish_state(confirmed);
+          this->request_number_update_(pending.number);
         }
       }
       break;
-    case PendingCommand::Type::EMETER_THREE_PHASE_WRITE:
-      if (this->emeter_three_phase_switch_ != nullptr) {
-        if (success) {
-          this->emeter_three_phase_switch_->publish_state(pending.bool_value);
-        } else {
-          this->request_emeter_three_phase_update();
+    case PendingCommand::Type::SUBSCRIPTION:
+      if (!success) {
+        // Forget what the EVSE holds for this target so the next sync resends it.
+        if (pending.subscription_target == SUBSCRIPTION_TARGET_ALL) {
+          this->subscriptions_applied_.fill(SUBSCRIPTION_UNKNOWN);
+        } else if (pending.subscription_target < this->subscriptions_applied_.size()) {
+          this->subscriptions_applied_[pending.subscription_target] = SUBSCRIPTION_UNKNOWN;
         }
+        this->subscriptions_dirty_ = true;
       }
       break;
-    case PendingCommand::Type::NUMBER_WRITE:
-      if (pending.number != nullptr) {
-        if (success) {
-          this->publish_scaled_number_(pending.number, pending.scaled_value);
-        } else {
-          this->request_number_update_(pending.number);
+    case PendingCommand::Type::RAW:
+      // Only the command that was sent owns the captured lines.
+      if (pending.sent) {
+        std::vector<std::string_view> lines;
+        std::string_view rest(this->raw_response_);
+        while (!rest.empty()) {
+          const size_t end = std::min(rest.find('\n'), rest.size());
+          lines.push_back(rest.substr(0, end));
+          rest.remove_prefix(std::min(end + 1, rest.size()));
         }
+        this->finish_command_(pending, success, millis() - pending.queued_time, lines);
+        this->raw_response_.clear();
+        return;
       }
       break;
+    case PendingCommand::Type::PROBE:
     case PendingCommand::Type::GENERIC:
       break;
   }
+  this->finish_command_(pending, success, millis() - pending.queued_time);
+}
+
+void ESP32EVSEComponent::note_abandoned_(const PendingCommand &pending) {
+  for (size_t i = 0; i < sizeof(kProbeCommands) / sizeof(kProbeCommands[0]); ++i) {
+    if (std::strcmp(pending.command.c_str(), kProbeCommands[i]) == 0)
+      this->abandoned_probes_ |= 1u << i;
+  }
+}
+
+void ESP32EVSEComponent::queue_probe_() {
+  // Once every candidate has been abandoned, the oldest of those replies are
+  // several timeouts old and no longer expected.
+  if (this->abandoned_probes_ == kAllProbeCommands) {
+    ESP_LOGD(TAG, "Every probe query was abandoned; starting over");
+    this->abandoned_probes_ = 0;
+  }
+  size_t index = 0;
+  while ((this->abandoned_probes_ & (1u << index)) != 0)
+    ++index;
+  PendingCommand probe;
+  probe.type = PendingCommand::Type::PROBE;
+  probe.priority = CommandPriority::SAFETY;
+  probe.command.assign(kProbeCommands[index]);
+  probe.queued_time = millis();
+  size_t in_flight = 0;
+  while (in_flight < this->pending_commands_.size() && this->pending_commands_[in_flight].sent)
+    ++in_flight;
+  // A queue too full to take the probe is given up on rather than stalled.
+  if (this->pending_commands_.full())
+    this->fail_pending_commands_();
+  this->pending_commands_.insert(std::min(in_flight, this->pending_commands_.size()), probe);
   this->process_next_command_();
 }
 
-// Send the next queued command if we are not already waiting for a reply.
-void ESP32EVSEComponent::process_next_command_() {
-  if (this->pending_commands_.empty())
-    return;
+// Fail every queued command, as if each had timed out.  Writes roll back and
+// request a re-read, which is refused until the link is back.
+void ESP32EVSEComponent::fail_pending_commands_() {
+  while (!this->pending_commands_.empty()) {
+    PendingCommand pending = this->pending_commands_.front();
+    this->pending_commands_.pop_front();
+    this->complete_command_(pending, false);
+  }
+}
 
-  auto &front = this->pending_commands_.front();
-  if (front.sent)
+// Keep a short history of round trips and derive the command timeout from its
+// p99.  With ``RTT_SAMPLES`` entries that is effectively the slowest recent
+// reply, which is what a timeout has to tolerate.
+void ESP32EVSEComponent::record_round_trip_(uint32_t rtt_ms) {
+  this->rtt_samples_[this->rtt_sample_next_] =
+      static_cast<uint16_t>(std::min<uint32_t>(rtt_ms, std::numeric_limits<uint16_t>::max()));
+  this->rtt_sample_next_ = (this->rtt_sample_next_ + 1) % RTT_SAMPLES;
+  if (this->rtt_sample_count_ < RTT_SAMPLES)
+    ++this->rtt_sample_count_;
+  if (this->rtt_sample_count_ < kMinRttSamples)
     return;
 
-  ESP_LOGV(TAG, "Sending command: %s", front.command.c_str());
-  this->write_str(front.command.c_str());
-  this->write_str("\n");
-  front.start_time = millis();
-  front.sent = true;
+  std::array<uint16_t, RTT_SAMPLES> sorted = this->rtt_samples_;
+  const size_t count = this->rtt_sample_count_;
+  const size_t p99_index = (count * 99 + 99) / 100 - 1;
+  std::nth_element(sorted.begin(), sorted.begin() + p99_index, sorted.begin() + count);
+  const uint32_t timeout = static_cast<uint32_t>(sorted[p99_index]) * kCommandTimeoutFactor;
+  this->command_timeout_ms_ = std::clamp(timeout, kMinCommandTimeoutMs, kMaxCommandTimeoutMs);
+}
+
+size_t ESP32EVSEComponent::LatencyHistogram::bucket_for(uint32_t ms) {
+  size_t bucket = 0;
+  while (ms != 0 && bucket < BUCKETS - 1) {
+    ms >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void ESP32EVSEComponent::LatencyHistogram::record(uint32_t ms) {
+  ++this->counts[bucket_for(ms)];
+  ++this->samples;
+  this->total_ms += ms;
+  this->max_ms = std::max(this->max_ms, ms);
+}
+
+uint32_t ESP32EVSEComponent::LatencyHistogram::percentile(uint8_t percent) const {
+  if (this->samples == 0)
+    return 0;
+  const uint32_t target = static_cast<uint32_t>((static_cast<uint64_t>(this->samples) * percent + 99) / 100);
+  uint32_t seen = 0;
+  for (size_t i = 0; i < BUCKETS; ++i) {
+    if (this->counts[i] == 0 || seen + this->counts[i] < target) {
+      seen += this->counts[i];
+      continue;
+    }
+    const uint32_t lower = i == 0 ? 0 : 1u << (i - 1);
+    const uint32_t upper = i == BUCKETS - 1 ? std::max(this->max_ms, lower) : 1u << i;
+    const uint32_t estimate =
+        lower + static_cast<uint32_t>(static_cast<uint64_t>(upper - lower) * (target - seen) / this->counts[i]);
+    return std::min(estimate, this->max_ms);
+  }
+  return this->max_ms;
+}
+
+ESP32EVSEComponent::CommandPriority ESP32EVSEComponent::command_priority_(const PendingCommand &pending) {
+  switch (pending.type) {
+    case PendingCommand::Type::PROBE:
+      return CommandPriority::SAFETY;
+    case PendingCommand::Type::ENABLE_WRITE:
+    case PendingCommand::Type::AVAILABLE_WRITE:
+    case PendingCommand::Type::REQUEST_AUTHORIZATION_WRITE:
+    case PendingCommand::Type::EMETER_THREE_PHASE_WRITE:
+    case PendingCommand::Type::NUMBER_WRITE:
+    case PendingCommand::Type::RAW:
+      return CommandPriority::USER;
+    case PendingCommand::Type::SUBSCRIPTION:
+      return CommandPriority::CONTROL;
+    case PendingCommand::Type::GENERIC:
+      break;
+  }
+  return pending.priority;
+}
+
+ESP32EVSEComponent::CommandPriority ESP32EVSEComponent::effective_priority_(const PendingCommand &pending,
+                                                                            uint32_t now) {
+  const auto index = static_cast<size_t>(pending.priority);
+  return now - pending.queued_time >= kPriorityMaxWaitMs[index] ? CommandPriority::SAFETY : pending.priority;
+}
+
+ESP32EVSEComponent::CommandClass ESP32EVSEComponent::classify_command_(const PendingCommand &pending) {
+  switch (pending.type) {
+    case PendingCommand::Type::SUBSCRIPTION:
+      return CommandClass::SUBSCRIBE;
+    case PendingCommand::Type::GENERIC:
+    case PendingCommand::Type::RAW:
+      return pending.command.is_query() ? CommandClass::QUERY : CommandClass::WRITE;
+    case PendingCommand::Type::PROBE:
+      return CommandClass::QUERY;
+    default:
+      return CommandClass::WRITE;
+  }
+}
+
+void ESP32EVSEComponent::publish_command_stats_() {
+  static constexpr uint8_t kPublishedPercentile = 95;
+  const EntityId latency_sensors[COMMAND_CLASS_COUNT] = {EntityId::QUERY_LATENCY, EntityId::WRITE_LATENCY,
+                                                        EntityId::SUBSCRIBE_LATENCY};
+  for (size_t i = 0; i < COMMAND_CLASS_COUNT; ++i) {
+    const auto &histogram = this->round_trip_histograms_[i];
+    if (this->has_entity_(latency_sensors[i]) && histogram.samples > 0)
+      this->publish_sensor_(latency_sensors[i], histogram.percentile(kPublishedPercentile));
+  }
+  if (this->has_entity_(EntityId::QUEUE_WAIT) && this->queue_wait_histogram_.samples > 0)
+    this->publish_sensor_(EntityId::QUEUE_WAIT, this->queue_wait_histogram_.percentile(kPublishedPercentile));
+  this->publish_sensor_(EntityId::QUEUE_HIGH_WATER, this->queue_high_water_mark_);
+  this->publish_sensor_(EntityId::DROPPED_COMMANDS, this->dropped_commands_);
+}
+
+// Summary plus the non-empty buckets as ``<upper bound>:<count>`` pairs.
+void ESP32EVSEComponent::log_command_stats_() {
+  static const char *const CLASS_NAMES[] = {"Query", "Write", "Subscribe"};
+  auto log_histogram = [](const char *name, const LatencyHistogram &histogram) {
+    ESP_LOGCONFIG(TAG,
+                  "  %s: %" PRIu32 " samples, mean %" PRIu32 " ms, p50 %" PRIu32 " ms, p95 %" PRIu32
+                  " ms, max %" PRIu32 " ms, %" PRIu32 " timeouts",
+                  name, histogram.samples, histogram.mean(), histogram.percentile(50), histogram.percentile(95),
+                  histogram.max_ms, histogram.timeouts);
+    if (histogram.samples == 0)
+      return;
+    char buckets[LatencyHistogram::BUCKETS * 20];
+    size_t length = 0;
+    for (size_t i = 0; i < LatencyHistogram::BUCKETS; ++i) {
+      if (histogram.counts[i] == 0)
+        continue;
+      const int written = i == LatencyHistogram::BUCKETS - 1
+                              ? snprintf(buckets + length, sizeof(buckets) - length, " inf:%" PRIu32, histogram.counts[i])
+                              : snprintf(buckets + length, sizeof(buckets) - length, " <%u:%" PRIu32, 1u << i,
+                                         histogram.counts[i]);
+      if (written < 0)
+        break;
+      length = std::min(length + static_cast<size_t>(written), sizeof(buckets) - 1);
+    }
+    ESP_LOGCONFIG(TAG, "   ms%s", buckets);
+  };
+  ESP_LOGCONFIG(TAG, "Command Round Trips:");
+  for (size_t i = 0; i < COMMAND_CLASS_COUNT; ++i)
+    log_histogram(CLASS_NAMES[i], this->round_trip_histograms_[i]);
+  log_histogram("Queue Wait", this->queue_wait_histogram_);
+  static const char *const PRIORITY_NAMES[] = {"Safety Wait", "User Wait", "Control Wait", "Background Wait"};
+  for (size_t i = 0; i < COMMAND_PRIORITY_COUNT; ++i)
+    log_histogram(PRIORITY_NAMES[i], this->priority_wait_histograms_[i]);
+  ESP_LOGCONFIG(TAG, "  Queue High-Water Mark: %u of %u, %" PRIu32 " dropped",
+                static_cast<unsigned>(this->queue_high_water_mark_),
+                static_cast<unsigned>(PendingCommandQueue::CAPACITY), this->dropped_commands_);
+}
+
+void ESP32EVSEComponent::set_link_state_(LinkState state) {
+  if (state == this->link_state_)
+    return;
+  static const char *const LINK_STATE_NAMES[] = {"UP", "DEGRADED", "DOWN"};
+  const LinkState previous = this->link_state_;
+  this->link_state_ = state;
+  const char *name = LINK_STATE_NAMES[static_cast<uint8_t>(state)];
+  if (state == LinkState::UP) {
+    ESP_LOGI(TAG, "ESP32-EVSE link %s", name);
+  } else {
+    ESP_LOGW(TAG, "ESP32-EVSE link %s", name);
+  }
+  this->publish_text_sensor_state_(EntityId::LINK_STATE, name);
+
+  if (state == LinkState::DOWN) {
+    this->probe_backoff_ms_ = kMinProbeIntervalMs;
+    this->last_probe_ms_ = millis();
+    // Whatever was queued for the EVSE is lost; start from a clean slate.
+    this->subscriptions_applied_.fill(SUBSCRIPTION_UNKNOWN);
+    this->subscriptions_dirty_ = true;
+  } else if (previous == LinkState::DOWN) {
+    if (this->boot_stage_ != BootStage::DONE) {
+      // The EVSE was not answering during startup; start over with the
+      // control data instead of sending everything at once.
+      this->boot_stage_ = BootStage::CONTROL;
+      this->queue_boot_stage_(BootStage::CONTROL);
+      return;
+    }
+    // Everything published while the link was down may be stale.
+    this->sync_subscriptions_();
+    this->perform_update_(true);
+  }
+}
+
+// Send queued commands until ``command_window_`` of them await a reply.  The
+// EVSE answers strictly in order, so the in-flight commands are always the
+// leading entries of the queue.
+void ESP32EVSEComponent::process_next_command_() {
+  size_t in_flight = 0;
+  while (in_flight < this->pending_commands_.size() && this->pending_commands_[in_flight].sent)
+    ++in_flight;
+
+  // A struggling link gets one command at a time, as does a recovered one until
+  // it has proven itself again; while it is down only the probe is ever queued.
+  const size_t window =
+      this->link_state_ == LinkState::UP && this->serial_acks_remaining_ == 0 ? this->command_window_ : 1;
+  const uint32_t now = millis();
+  for (; in_flight < window && in_flight < this->pending_commands_.size(); ++in_flight) {
+    auto &next = this->pending_commands_[in_flight];
+    if (this->resyncing_) {
+      if (next.type != PendingCommand::Type::PROBE)
+        break;
+      this->resync_line_seen_ = false;
+    }
+    // Only queries share the window: a lost ack would hand a write the
+    // outcome of its neighbour, and writes have no reply line to notice by.
+    if (in_flight > 0 &&
+        !(is_query_command(std::string_view(next.command.c_str(), next.command.size())) &&
+          is_query_command(std::string_view(this->pending_commands_[in_flight - 1].command.c_str(),
+                                            this->pending_commands_[in_flight - 1].command.size()))))
+      break;
+    ESP_LOGV(TAG, "Sending command: %s", next.command.c_str());
+    this->write_str(next.command.c_str());
+    this->write_str("\n");
+    next.start_time = now;
+    next.sent = true;
+    this->queue_wait_histogram_.record(now - next.queued_time);
+    this->priority_wait_histograms_[static_cast<size_t>(next.priority)].record(now - next.queued_time);
+  }
 }
 
 // Publish EVSE state machine codes (A/B/C/etc.) to the bound text sensor.
@@ -1172,363 +2932,416 @@ void ESP32EVSEComponent::update_state_(uint8_t state) {
   if (state < sizeof(STATE_NAMES) / sizeof(STATE_NAMES[0])) {
     state_name = STATE_NAMES[state];
   }
-  this->publish_text_sensor_state_(this->state_text_sensor_, state_name);
-}
-
-// Mirror EVSE flags back into ESPHome entities.
-void ESP32EVSEComponent::update_enable_(bool enable) {
-  this->mark_response_received_(FreshnessSlot::ENABLE);
-  // Ignore subscription echoes while a matching command is awaiting an
-  // acknowledgement so we only flip the switch state once.
-  if (this->is_front_sent_write_(PendingCommand::Type::ENABLE_WRITE))
-    return;
-  if (this->enable_switch_ != nullptr) {
-    this->enable_switch_->publish_state(enable);
-  }
+  this->publish_text_sensor_state_(EntityId::STATE, state_name);
+  this->check_state_ready_();
 }
 
 // Publish the EVSE's reported temperature extremes.  Values are sent in
 // centi-degrees, so we convert to Celsius before forwarding them.
 void ESP32EVSEComponent::update_temperature_(int count, int32_t high, int32_t low) {
   this->mark_response_received_(FreshnessSlot::TEMPERATURE);
-  if (this->temperature_high_sensor_ == nullptr && this->temperature_low_sensor_ == nullptr)
-    return;
+#ifdef USE_ESP32EVSE_TELEMETRY
+  if (count > 0) {
+    this->record_telemetry_(TelemetryChannel::TEMPERATURE_HIGH, high);
+    this->record_telemetry_(TelemetryChannel::TEMPERATURE_LOW, low);
+  }
+#endif
   if (count <= 0) {
-    if (this->temperature_high_sensor_ != nullptr)
-      this->temperature_high_sensor_->publish_state(NAN);
-    if (this->temperature_low_sensor_ != nullptr)
-      this->temperature_low_sensor_->publish_state(NAN);
+    this->publish_sensor_(EntityId::TEMPERATURE_HIGH, NAN);
+    this->publish_sensor_(EntityId::TEMPERATURE_LOW, NAN);
     return;
   }
-  float high_c = high / 100.0f;
-  float low_c = low / 100.0f;
-  if (this->temperature_high_sensor_ != nullptr)
-    this->temperature_high_sensor_->publish_state(high_c);
-  if (this->temperature_low_sensor_ != nullptr)
-    this->temperature_low_sensor_->publish_state(low_c);
+  this->publish_sensor_(EntityId::TEMPERATURE_HIGH, high / 100.0f);
+  this->publish_sensor_(EntityId::TEMPERATURE_LOW, low / 100.0f);
 }
 
 // Helper: convert the raw integer value reported by the EVSE into the scaled
-// float the number entity expects before publishing it.
-void ESP32EVSEComponent::publish_scaled_number_(ESP32EVSEChargingCurrentNumber *number, float raw_value) {
+// float the number entity expects before publishing it.  This is the only
+// floating point step on the way from the UART to a number entity.
+void ESP32EVSEComponent::publish_scaled_number_(ESP32EVSEChargingCurrentNumber *number, int64_t raw_value,
+                                                bool force) {
   if (number == nullptr)
     return;
-  if (this->is_front_sent_write_(PendingCommand::Type::NUMBER_WRITE, number))
+  if (this->is_write_in_flight_(PendingCommand::Type::NUMBER_WRITE, number))
     return;
-  // Convert the EVSE's integer back into the human-friendly engineering units
-  // expected by the ESPHome number entity before reporting it.
+  float value = this->scaled_number_value_(number, raw_value);
+  if (this->confirm_value_(number, value) && this->should_publish_(this->number_id_(number), value, force))
+    number->publish_state(value);
+}
+
+// Convert the EVSE's integer back into the human-friendly engineering units
+// expected by the ESPHome number entity.
+float ESP32EVSEComponent::scaled_number_value_(const ESP32EVSEChargingCurrentNumber *number, int64_t raw_value) const {
   float multiplier = number->get_multiplier();
   if (multiplier == 0.0f)
     multiplier = 1.0f;
-  float value = raw_value / multiplier;
-  number->publish_state(value);
+  return static_cast<float>(raw_value) / multiplier;
+}
+
+void ESP32EVSEComponent::publish_sensor_(EntityId id, float value) {
+  auto *sensor = this->entity_<sensor::Sensor>(id);
+  if (sensor != nullptr && this->should_publish_(id, value, false))
+    sensor->publish_state(value);
+}
+
+void ESP32EVSEComponent::publish_binary_sensor_(EntityId id, bool value) {
+  auto *sensor = this->entity_<binary_sensor::BinarySensor>(id);
+  if (sensor != nullptr && this->should_publish_(id, value ? 1.0f : 0.0f, false))
+    sensor->publish_state(value);
+}
+
+// ``force`` is used for write acknowledgements: the entity must reflect the
+// outcome even if the same state was published before the write.
+void ESP32EVSEComponent::publish_switch_(EntityId id, bool value, bool force) {
+  auto *sw = this->entity_<switch_::Switch>(id);
+  if (sw != nullptr && this->should_publish_(id, value ? 1.0f : 0.0f, force))
+    sw->publish_state(value);
+}
+
+// Each id is registered at most once, so ``entities_`` never outgrows the
+// one-byte index.
+void ESP32EVSEComponent::register_entity(EntityId id, EntityBase *entity) {
+  const size_t index = static_cast<size_t>(id);
+  if (entity == nullptr || index >= this->entity_index_.size())
+    return;
+  if (this->entity_index_[index] != NO_ENTITY) {
+    this->entities_[this->entity_index_[index]].entity = entity;
+    return;
+  }
+  this->entity_index_[index] = static_cast<uint8_t>(this->entities_.size());
+  RegisteredEntity registered{entity, {}};
+  // Only sensors publish repeated readings by default.
+  registered.filter.only_on_change = entity_kind(id) != EntityKind::SENSOR;
+  this->entities_.push_back(registered);
+}
+
+void ESP32EVSEComponent::set_publish_filter(EntityBase *entity, float delta, bool relative, uint32_t min_interval_ms,
+                                            bool only_on_change) {
+  // Configuration time only, so a scan of the registry is fine here.
+  for (auto &registered : this->entities_) {
+    if (registered.entity == entity) {
+      registered.filter.delta = delta;
+      registered.filter.relative = relative;
+      registered.filter.min_interval_ms = min_interval_ms;
+      registered.filter.only_on_change = only_on_change;
+      return;
+    }
+  }
+}
+
+// Decide whether ``value`` is worth publishing for ``id`` and remember it if
+// so.  Runs on every received line, so it only indexes the registry and
+// compares a few floats.  Entities outside the registry are not filtered.
+bool ESP32EVSEComponent::should_publish_(EntityId id, float value, bool force) {
+  const size_t index = static_cast<size_t>(id);
+  if (index >= this->entity_index_.size() || this->entity_index_[index] == NO_ENTITY)
+    return true;
+  PublishFilter *filter = &this->entities_[this->entity_index_[index]].filter;
+
+  const uint32_t now = millis();
+  if (!force && filter->has_last) {
+    if (filter->min_interval_ms != 0 && now - filter->last_publish_ms < filter->min_interval_ms) {
+      ++this->suppressed_publishes_;
+      return false;
+    }
+    const bool was_nan = std::isnan(filter->last_value);
+    const bool is_nan = std::isnan(value);
+    bool suppress;
+    if (was_nan || is_nan) {
+      suppress = was_nan && is_nan && filter->only_on_change;
+    } else {
+      const float threshold = filter->relative ? std::fabs(filter->last_value) * filter->delta : filter->delta;
+      suppress = (filter->delta > 0.0f || filter->only_on_change) && std::fabs(value - filter->last_value) <= threshold;
+    }
+    if (suppress) {
+      ++this->suppressed_publishes_;
+      return false;
+    }
+  }
+  filter->has_last = true;
+  filter->last_value = value;
+  filter->last_publish_ms = now;
+  return true;
 }
 
 // Helper: only publish text sensor updates when the value actually changes to
 // avoid unnecessary state spam for subscribers.
-void ESP32EVSEComponent::publish_text_sensor_state_(text_sensor::TextSensor *sensor,
-                                                    const std::string &state) {
+void ESP32EVSEComponent::publish_text_sensor_state_(EntityId id, std::string_view state) {
+  auto *sensor = this->entity_<text_sensor::TextSensor>(id);
   if (sensor == nullptr)
     return;
   if (sensor->has_state() && sensor->state == state)
     return;
-  sensor->publish_state(state);
-}
-
-bool ESP32EVSEComponent::has_error_binary_sensors_() const {
-  return this->pilot_fault_binary_sensor_ != nullptr ||
-         this->diode_short_binary_sensor_ != nullptr ||
-         this->lock_fault_binary_sensor_ != nullptr ||
-         this->unlock_fault_binary_sensor_ != nullptr ||
-         this->rcm_triggered_binary_sensor_ != nullptr ||
-         this->rcm_self_test_fault_binary_sensor_ != nullptr ||
-         this->temperature_high_fault_binary_sensor_ != nullptr ||
-         this->temperature_fault_binary_sensor_ != nullptr;
+  sensor->publish_state(std::string(state));
 }
 
 void ESP32EVSEComponent::update_charging_current_(uint16_t value_tenths) {
   this->mark_response_received_(FreshnessSlot::CHARGING_CURRENT);
-  this->publish_scaled_number_(this->charging_current_number_, value_tenths);
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+  // Changes made elsewhere (the web UI, Home Assistant) are corrected on the
+  // next grid sample.
+  auto *number = this->number_entity_(EntityId::CHARGING_CURRENT);
+  if (!this->is_write_in_flight_(PendingCommand::Type::NUMBER_WRITE, number))
+    this->charging_current_tenths_ = value_tenths;
+  this->publish_scaled_number_(number, value_tenths);
+#else
+  this->publish_scaled_number_(this->number_entity_(EntityId::CHARGING_CURRENT), value_tenths);
+#endif
 }
 
 void ESP32EVSEComponent::update_emeter_power_(uint32_t power_w) {
   this->mark_response_received_(FreshnessSlot::EMETER_POWER);
-  if (this->emeter_power_sensor_ != nullptr) {
-    this->emeter_power_sensor_->publish_state(power_w);
-  }
-}
-
-void ESP32EVSEComponent::update_emeter_session_time_(uint32_t time_s) {
-  this->mark_response_received_(FreshnessSlot::EMETER_SESSION_TIME);
-  if (this->emeter_session_time_sensor_ != nullptr) {
-    this->emeter_session_time_sensor_->publish_state(time_s);
-  }
-}
-
-void ESP32EVSEComponent::update_emeter_charging_time_(uint32_t time_s) {
-  this->mark_response_received_(FreshnessSlot::EMETER_CHARGING_TIME);
-  if (this->emeter_charging_time_sensor_ != nullptr) {
-    this->emeter_charging_time_sensor_->publish_state(time_s);
+  this->meter_readings_.power_w = power_w;
+  if (this->has_entity_(EntityId::SESSION_ENERGY))
+    this->integrate_power_(power_w);
+#ifdef USE_ESP32EVSE_TELEMETRY
+  this->record_telemetry_(TelemetryChannel::POWER, power_w);
+#endif
+  this->publish_sensor_(EntityId::EMETER_POWER, power_w);
+}
+
+// Publish the reply of a plain ``SLOT_QUERIES`` slot.  Numbers are scaled so
+// ESPHome users interact with human readable units instead of protocol
+// specific integers.
+void ESP32EVSEComponent::publish_slot_value_(const SlotQuery &query, int64_t raw_value) {
+  this->mark_response_received_(query.slot);
+  switch (entity_kind(query.entity)) {
+    case EntityKind::SENSOR:
+      this->publish_sensor_(query.entity, static_cast<float>(raw_value));
+      break;
+    case EntityKind::BINARY_SENSOR:
+      this->publish_binary_sensor_(query.entity, raw_value != 0);
+      break;
+    case EntityKind::NUMBER:
+      this->publish_scaled_number_(this->number_entity_(query.entity), raw_value);
+      break;
+    case EntityKind::SWITCH: {
+      ESP32EVSEOptimisticEntity *entity = this->switch_state_(query.entity);
+      if (entity == nullptr)
+        break;
+      // Echoes of a write still waiting for its ``OK`` are left to the write,
+      // so the switch only flips once.
+      for (const SwitchWrite &write : SWITCH_WRITES) {
+        if (write.entity == query.entity && this->is_write_in_flight_(write.type))
+          return;
+      }
+      if (this->confirm_value_(entity, raw_value != 0 ? 1.0f : 0.0f))
+        this->publish_switch_(query.entity, raw_value != 0);
+      break;
+    }
+    case EntityKind::TEXT_SENSOR:
+      break;
   }
 }
 
-void ESP32EVSEComponent::update_uptime_(uint32_t seconds) {
-  this->mark_response_received_(FreshnessSlot::UPTIME);
-  if (this->uptime_sensor_ != nullptr) {
-    this->uptime_sensor_->publish_state(seconds);
-  }
+void ESP32EVSEComponent::publish_slot_text_(const SlotQuery &query, std::string_view text) {
+  this->mark_response_received_(query.slot);
+  if (entity_kind(query.entity) == EntityKind::TEXT_SENSOR)
+    this->publish_text_sensor_state_(query.entity, text);
 }
 
-void ESP32EVSEComponent::update_chip_(const std::string &chip) {
+void ESP32EVSEComponent::update_chip_(std::string_view chip) {
   this->mark_response_received_(FreshnessSlot::CHIP);
-  this->publish_text_sensor_state_(this->chip_text_sensor_, chip);
+  this->publish_text_sensor_state_(EntityId::CHIP, chip);
 }
 
-void ESP32EVSEComponent::update_version_(const std::string &version) {
+void ESP32EVSEComponent::update_version_(std::string_view version) {
   this->mark_response_received_(FreshnessSlot::VERSION);
-  this->publish_text_sensor_state_(this->version_text_sensor_, version);
+#ifdef USE_ESP32EVSE_WARM_START
+  this->check_fingerprint_(FreshnessSlot::VERSION, version);
+#endif
+  this->publish_text_sensor_state_(EntityId::VERSION, version);
 }
 
-void ESP32EVSEComponent::update_idf_version_(const std::string &idf_version) {
-  this->mark_response_received_(FreshnessSlot::IDF_VERSION);
-  this->publish_text_sensor_state_(this->idf_version_text_sensor_, idf_version);
-}
-
-void ESP32EVSEComponent::update_build_time_(const std::string &build_time) {
+void ESP32EVSEComponent::update_build_time_(std::string_view build_time) {
   this->mark_response_received_(FreshnessSlot::BUILD_TIME);
-  if (this->build_time_text_sensor_ == nullptr)
-    return;
-  std::string sanitized = build_time;
-  size_t pos = 0;
-  while ((pos = sanitized.find('"', pos)) != std::string::npos) {
-    sanitized.erase(pos, 1);
+  char sanitized[MAX_LINE_LENGTH + 1];
+  size_t length = 0;
+  for (char c : build_time) {
+    if (c != '"' && length < MAX_LINE_LENGTH)
+      sanitized[length++] = c;
   }
-  this->publish_text_sensor_state_(this->build_time_text_sensor_, sanitized);
+#ifdef USE_ESP32EVSE_WARM_START
+  this->check_fingerprint_(FreshnessSlot::BUILD_TIME, std::string_view(sanitized, length));
+#endif
+  this->publish_text_sensor_state_(EntityId::BUILD_TIME, std::string_view(sanitized, length));
 }
 
 void ESP32EVSEComponent::update_device_time_(uint32_t timestamp) {
   this->mark_response_received_(FreshnessSlot::DEVICE_TIME);
-  if (this->device_time_text_sensor_ == nullptr)
+  if (!this->has_entity_(EntityId::DEVICE_TIME))
     return;
   time_t raw_time = static_cast<time_t>(timestamp);
   struct tm tm_info;
   if (!localtime_r(&raw_time, &tm_info)) {
-    this->publish_text_sensor_state_(this->device_time_text_sensor_, "invalid");
+    this->publish_text_sensor_state_(EntityId::DEVICE_TIME, "invalid");
     return;
   }
   char buffer[32];
   if (strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M", &tm_info) == 0) {
-    this->publish_text_sensor_state_(this->device_time_text_sensor_, "invalid");
+    this->publish_text_sensor_state_(EntityId::DEVICE_TIME, "invalid");
     return;
   }
-  this->publish_text_sensor_state_(this->device_time_text_sensor_, buffer);
+  this->publish_text_sensor_state_(EntityId::DEVICE_TIME, buffer);
 }
 
-void ESP32EVSEComponent::update_wifi_sta_cfg_(const std::string &ssid) {
+void ESP32EVSEComponent::update_wifi_sta_cfg_(std::string_view ssid) {
   this->mark_response_received_(FreshnessSlot::WIFI_STA_CFG);
-  this->publish_text_sensor_state_(this->wifi_sta_ssid_text_sensor_, ssid);
-}
-
-void ESP32EVSEComponent::update_wifi_sta_ip_(const std::string &ip) {
-  this->mark_response_received_(FreshnessSlot::WIFI_STA_IP);
-  this->publish_text_sensor_state_(this->wifi_sta_ip_text_sensor_, ip);
+  this->publish_text_sensor_state_(EntityId::WIFI_STA_SSID, ssid);
 }
 
-void ESP32EVSEComponent::update_wifi_sta_mac_(const std::string &mac) {
-  this->mark_response_received_(FreshnessSlot::WIFI_STA_MAC);
-  this->publish_text_sensor_state_(this->wifi_sta_mac_text_sensor_, mac);
+void ESP32EVSEComponent::update_heap_(std::optional<uint32_t> heap_used_bytes,
+                                      std::optional<uint32_t> heap_total_bytes) {
+  this->mark_response_received_(FreshnessSlot::HEAP);
+  if (heap_used_bytes.has_value())
+    this->publish_sensor_(EntityId::HEAP_USED, *heap_used_bytes);
+  if (heap_total_bytes.has_value())
+    this->publish_sensor_(EntityId::HEAP_TOTAL, *heap_total_bytes);
 }
 
-void ESP32EVSEComponent::update_device_name_(const std::string &name) {
-  this->mark_response_received_(FreshnessSlot::DEVICE_NAME);
-  this->publish_text_sensor_state_(this->device_name_text_sensor_, name);
+// Energy, voltages and currents stay integers (Wh, mV, mA) from the parser up
+// to here; they only become ``float`` for the sensor itself, and only when a
+// sensor is configured.
+void ESP32EVSEComponent::update_energy_consumption_(int64_t value_wh) {
+  this->mark_response_received_(FreshnessSlot::ENERGY_CONSUMPTION);
+  this->meter_readings_.energy_wh = value_wh;
+  if (this->has_entity_(EntityId::SESSION_ENERGY))
+    this->anchor_session_energy_(value_wh);
+  this->publish_sensor_(EntityId::ENERGY_CONSUMPTION, static_cast<float>(value_wh));
 }
 
-void ESP32EVSEComponent::update_available_(bool available) {
-  this->mark_response_received_(FreshnessSlot::AVAILABLE);
-  // Defer publishing until the queued write completes to prevent flicker from
-  // the immediate subscription update.
-  if (this->is_front_sent_write_(PendingCommand::Type::AVAILABLE_WRITE))
+// Trapezoidal integration over the ``millis()`` spacing of the power samples.
+// The published value never goes backwards within a session: when the local
+// sum ran ahead of the EVSE counter it holds until the two agree again.
+void ESP32EVSEComponent::integrate_power_(uint32_t power_w) {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->last_power_ms_;
+  const bool integrate = this->has_last_power_ && elapsed <= kMaxIntegrationGapMs;
+  if (integrate)
+    this->session_energy_since_anchor_mj_ += (uint64_t{this->last_power_w_} + power_w) * elapsed / 2;
+  this->last_power_w_ = power_w;
+  this->last_power_ms_ = now;
+  this->has_last_power_ = true;
+  if (!integrate || this->session_energy_anchor_wh_ < 0)
     return;
-  if (this->available_switch_ != nullptr) {
-    this->available_switch_->publish_state(available);
-  }
-}
-
-void ESP32EVSEComponent::update_request_authorization_(bool request) {
-  this->mark_response_received_(FreshnessSlot::REQUEST_AUTHORIZATION);
-  // Hold back the remote state until the command queue confirms the user's
-  // desired value.
-  if (this->is_front_sent_write_(PendingCommand::Type::REQUEST_AUTHORIZATION_WRITE))
+  const float energy_wh = static_cast<float>(this->session_energy_anchor_wh_) +
+                          static_cast<float>(this->session_energy_since_anchor_mj_) / kMillijoulesPerWattHour;
+  if (energy_wh <= this->session_energy_published_wh_)
     return;
-  if (this->request_authorization_switch_ != nullptr) {
-    this->request_authorization_switch_->publish_state(request);
-  }
+  this->session_energy_published_wh_ = energy_wh;
+  this->publish_sensor_(EntityId::SESSION_ENERGY, energy_wh);
 }
 
-void ESP32EVSEComponent::update_emeter_three_phase_(bool enabled) {
-  this->mark_response_received_(FreshnessSlot::EMETER_THREE_PHASE);
-  if (this->is_front_sent_write_(PendingCommand::Type::EMETER_THREE_PHASE_WRITE))
+void ESP32EVSEComponent::anchor_session_energy_(int64_t value_wh) {
+  if (value_wh == this->session_energy_anchor_wh_)
     return;
-  if (this->emeter_three_phase_switch_ != nullptr) {
-    this->emeter_three_phase_switch_->publish_state(enabled);
-  }
-}
-
-void ESP32EVSEComponent::update_heap_(std::optional<uint32_t> heap_used_bytes,
-                                      std::optional<uint32_t> heap_total_bytes) {
-  this->mark_response_received_(FreshnessSlot::HEAP);
-  if (heap_used_bytes.has_value() && this->heap_used_sensor_ != nullptr) {
-    this->heap_used_sensor_->publish_state(*heap_used_bytes);
-  }
-  if (heap_total_bytes.has_value() && this->heap_total_sensor_ != nullptr) {
-    this->heap_total_sensor_->publish_state(*heap_total_bytes);
-  }
-}
-
-void ESP32EVSEComponent::update_energy_consumption_(float value) {
-  this->mark_response_received_(FreshnessSlot::ENERGY_CONSUMPTION);
-  if (this->energy_consumption_sensor_ != nullptr) {
-    this->energy_consumption_sensor_->publish_state(value);
-  }
+  // A lower counter means a new session; follow it down.
+  if (value_wh < this->session_energy_anchor_wh_)
+    this->session_energy_published_wh_ = 0.0f;
+  this->session_energy_anchor_wh_ = value_wh;
+  this->session_energy_since_anchor_mj_ = 0;
+  const float energy_wh = static_cast<float>(value_wh);
+  if (energy_wh < this->session_energy_published_wh_)
+    return;
+  this->session_energy_published_wh_ = energy_wh;
+  this->publish_sensor_(EntityId::SESSION_ENERGY, energy_wh);
 }
 
-void ESP32EVSEComponent::update_total_energy_consumption_(float value) {
+void ESP32EVSEComponent::update_total_energy_consumption_(int64_t value_wh) {
   this->mark_response_received_(FreshnessSlot::TOTAL_ENERGY_CONSUMPTION);
-  if (this->total_energy_consumption_sensor_ != nullptr) {
-    this->total_energy_consumption_sensor_->publish_state(value);
-  }
+  this->meter_readings_.total_energy_wh = value_wh;
+  this->publish_sensor_(EntityId::TOTAL_ENERGY_CONSUMPTION, static_cast<float>(value_wh));
 }
 
-void ESP32EVSEComponent::update_voltages_(float l1, float l2, float l3) {
+void ESP32EVSEComponent::update_voltages_(int64_t l1_mv, int64_t l2_mv, int64_t l3_mv) {
   this->mark_response_received_(FreshnessSlot::VOLTAGE);
-  if (!std::isnan(l1))
-    l1 /= 1000.0f;
-  if (!std::isnan(l2))
-    l2 /= 1000.0f;
-  if (!std::isnan(l3))
-    l3 /= 1000.0f;
-  if (this->voltage_l1_sensor_ != nullptr)
-    this->voltage_l1_sensor_->publish_state(l1);
-  if (this->voltage_l2_sensor_ != nullptr)
-    this->voltage_l2_sensor_->publish_state(l2);
-  if (this->voltage_l3_sensor_ != nullptr)
-    this->voltage_l3_sensor_->publish_state(l3);
-}
-
-void ESP32EVSEComponent::update_currents_(float l1, float l2, float l3) {
+#ifdef USE_ESP32EVSE_TELEMETRY
+  this->record_telemetry_(TelemetryChannel::VOLTAGE_L1, l1_mv);
+  this->record_telemetry_(TelemetryChannel::VOLTAGE_L2, l2_mv);
+  this->record_telemetry_(TelemetryChannel::VOLTAGE_L3, l3_mv);
+#endif
+  this->publish_sensor_(EntityId::VOLTAGE_L1, milli_to_float(l1_mv));
+  this->publish_sensor_(EntityId::VOLTAGE_L2, milli_to_float(l2_mv));
+  this->publish_sensor_(EntityId::VOLTAGE_L3, milli_to_float(l3_mv));
+}
+
+void ESP32EVSEComponent::update_currents_(int64_t l1_ma, int64_t l2_ma, int64_t l3_ma) {
   this->mark_response_received_(FreshnessSlot::CURRENT);
-  if (!std::isnan(l1))
-    l1 /= 1000.0f;
-  if (!std::isnan(l2))
-    l2 /= 1000.0f;
-  if (!std::isnan(l3))
-    l3 /= 1000.0f;
-  if (this->current_l1_sensor_ != nullptr)
-    this->current_l1_sensor_->publish_state(l1);
-  if (this->current_l2_sensor_ != nullptr)
-    this->current_l2_sensor_->publish_state(l2);
-  if (this->current_l3_sensor_ != nullptr)
-    this->current_l3_sensor_->publish_state(l3);
+  this->meter_readings_.current_ma = {l1_ma, l2_ma, l3_ma};
+#ifdef USE_ESP32EVSE_TELEMETRY
+  this->record_telemetry_(TelemetryChannel::CURRENT_L1, l1_ma);
+  this->record_telemetry_(TelemetryChannel::CURRENT_L2, l2_ma);
+  this->record_telemetry_(TelemetryChannel::CURRENT_L3, l3_ma);
+#endif
+  this->publish_sensor_(EntityId::CURRENT_L1, milli_to_float(l1_ma));
+  this->publish_sensor_(EntityId::CURRENT_L2, milli_to_float(l2_ma));
+  this->publish_sensor_(EntityId::CURRENT_L3, milli_to_float(l3_ma));
 }
 
 void ESP32EVSEComponent::update_wifi_status_(bool connected, int rssi) {
   this->mark_response_received_(FreshnessSlot::WIFI_STATUS);
-  if (this->wifi_connected_binary_sensor_ != nullptr) {
-    this->wifi_connected_binary_sensor_->publish_state(connected);
-  }
-  if (this->wifi_rssi_sensor_ != nullptr) {
-    if (connected && rssi != std::numeric_limits<int>::min()) {
-      this->wifi_rssi_sensor_->publish_state(rssi);
-    } else {
-      this->wifi_rssi_sensor_->publish_state(NAN);
-    }
+  this->publish_binary_sensor_(EntityId::WIFI_CONNECTED, connected);
+  if (connected && rssi != std::numeric_limits<int>::min()) {
+    this->publish_sensor_(EntityId::WIFI_RSSI, rssi);
+  } else {
+    this->publish_sensor_(EntityId::WIFI_RSSI, NAN);
   }
 }
 
-// Forward various numeric reports from the EVSE to their corresponding number
-// entities.  Values are scaled so ESPHome users interact with human readable
-// units instead of protocol specific integers.
-void ESP32EVSEComponent::update_default_charging_current_(uint16_t value_tenths) {
-  this->mark_response_received_(FreshnessSlot::DEFAULT_CHARGING_CURRENT);
-  this->publish_scaled_number_(this->default_charging_current_number_, value_tenths);
-}
-
+// The maximum also caps charging current writes, so it is kept even without
+// a number entity.
 void ESP32EVSEComponent::update_maximum_charging_current_(uint16_t value_amps) {
   this->mark_response_received_(FreshnessSlot::MAXIMUM_CHARGING_CURRENT);
+  auto *number = this->number_entity_(EntityId::MAXIMUM_CHARGING_CURRENT);
   float limit = static_cast<float>(value_amps);
-  if (this->maximum_charging_current_number_ != nullptr) {
-    float multiplier = this->maximum_charging_current_number_->get_multiplier();
+  if (number != nullptr) {
+    float multiplier = number->get_multiplier();
     if (multiplier == 0.0f)
       multiplier = 1.0f;
     limit = value_amps / multiplier;
   }
   this->maximum_charging_current_limit_ = limit;
-  this->publish_scaled_number_(this->maximum_charging_current_number_, value_amps);
-}
-
-void ESP32EVSEComponent::update_consumption_limit_(float value) {
-  this->mark_response_received_(FreshnessSlot::CONSUMPTION_LIMIT);
-  this->publish_scaled_number_(this->consumption_limit_number_, value);
-}
-
-void ESP32EVSEComponent::update_default_consumption_limit_(float value) {
-  this->mark_response_received_(FreshnessSlot::DEFAULT_CONSUMPTION_LIMIT);
-  this->publish_scaled_number_(this->default_consumption_limit_number_, value);
-}
-
-void ESP32EVSEComponent::update_charging_time_limit_(uint32_t value) {
-  this->mark_response_received_(FreshnessSlot::CHARGING_TIME_LIMIT);
-  this->publish_scaled_number_(this->charging_time_limit_number_, static_cast<float>(value));
-}
-
-void ESP32EVSEComponent::update_default_charging_time_limit_(uint32_t value) {
-  this->mark_response_received_(FreshnessSlot::DEFAULT_CHARGING_TIME_LIMIT);
-  this->publish_scaled_number_(this->default_charging_time_limit_number_, static_cast<float>(value));
-}
-
-void ESP32EVSEComponent::update_under_power_limit_(float value) {
-  this->mark_response_received_(FreshnessSlot::UNDER_POWER_LIMIT);
-  this->publish_scaled_number_(this->under_power_limit_number_, value);
-}
-
-void ESP32EVSEComponent::update_default_under_power_limit_(float value) {
-  this->mark_response_received_(FreshnessSlot::DEFAULT_UNDER_POWER_LIMIT);
-  this->publish_scaled_number_(this->default_under_power_limit_number_, value);
-}
-
-void ESP32EVSEComponent::update_pending_authorization_(bool pending) {
-  this->mark_response_received_(FreshnessSlot::PENDING_AUTHORIZATION);
-  if (this->pending_authorization_binary_sensor_ != nullptr) {
-    this->pending_authorization_binary_sensor_->publish_state(pending);
-  }
-}
-
-void ESP32EVSEComponent::update_charging_limit_reached_(bool reached) {
-  this->mark_response_received_(FreshnessSlot::CHARGING_LIMIT_REACHED);
-  if (this->charging_limit_reached_binary_sensor_ != nullptr) {
-    this->charging_limit_reached_binary_sensor_->publish_state(reached);
-  }
+  this->publish_scaled_number_(number, value_amps);
 }
 
+// Only the bits that changed since the previous ``+ERROR`` are published, so a
+// subscribed mask that stays the same costs nothing beyond parsing.
 void ESP32EVSEComponent::update_error_flags_(uint32_t mask) {
   this->mark_response_received_(FreshnessSlot::ERROR_FLAGS);
-  if (this->pilot_fault_binary_sensor_ != nullptr)
-    this->pilot_fault_binary_sensor_->publish_state((mask & ERROR_FLAG_PILOT_FAULT) != 0u);
-  if (this->diode_short_binary_sensor_ != nullptr)
-    this->diode_short_binary_sensor_->publish_state((mask & ERROR_FLAG_DIODE_SHORT) != 0u);
-  if (this->lock_fault_binary_sensor_ != nullptr)
-    this->lock_fault_binary_sensor_->publish_state((mask & ERROR_FLAG_LOCK_FAULT) != 0u);
-  if (this->unlock_fault_binary_sensor_ != nullptr)
-    this->unlock_fault_binary_sensor_->publish_state((mask & ERROR_FLAG_UNLOCK_FAULT) != 0u);
-  if (this->rcm_triggered_binary_sensor_ != nullptr)
-    this->rcm_triggered_binary_sensor_->publish_state((mask & ERROR_FLAG_RCM_TRIGGERED) != 0u);
-  if (this->rcm_self_test_fault_binary_sensor_ != nullptr)
-    this->rcm_self_test_fault_binary_sensor_->publish_state((mask & ERROR_FLAG_RCM_SELF_TEST_FAULT) != 0u);
-  if (this->temperature_high_fault_binary_sensor_ != nullptr)
-    this->temperature_high_fault_binary_sensor_->publish_state((mask & ERROR_FLAG_TEMPERATURE_HIGH) != 0u);
-  if (this->temperature_fault_binary_sensor_ != nullptr)
-    this->temperature_fault_binary_sensor_->publish_state((mask & ERROR_FLAG_TEMPERATURE_FAULT) != 0u);
+  const uint32_t previous = this->error_flags_;
+  // The first mask after boot publishes every bit.
+  const uint32_t changed = this->has_error_flags_ ? mask ^ previous : ~uint32_t{0};
+  this->error_flags_ = mask;
+  this->has_error_flags_ = true;
+  if (changed == 0)
+    return;
+
+  this->publish_sensor_(EntityId::ERROR_MASK, static_cast<float>(mask));
+  // Binary sensor of each ``ERROR_FLAG_*`` bit, lowest bit first.
+  static constexpr EntityId FAULT_ENTITIES[] = {
+      EntityId::PILOT_FAULT,         EntityId::DIODE_SHORT,         EntityId::LOCK_FAULT,
+      EntityId::UNLOCK_FAULT,        EntityId::RCM_TRIGGERED,       EntityId::RCM_SELF_TEST_FAULT,
+      EntityId::TEMPERATURE_HIGH_FAULT, EntityId::TEMPERATURE_FAULT,
+  };
+  for (uint8_t bit = 0; bit < sizeof(FAULT_ENTITIES) / sizeof(FAULT_ENTITIES[0]); ++bit) {
+    const uint32_t flag = uint32_t{1} << bit;
+    if ((changed & flag) != 0u)
+      this->publish_binary_sensor_(FAULT_ENTITIES[bit], (mask & flag) != 0u);
+  }
+
+  // Bits that were never set do not count as cleared on the first mask.
+  const uint32_t raised = changed & mask;
+  const uint32_t cleared = changed & previous;
+  for (uint8_t bit = 0; bit < 32; ++bit) {
+    const uint32_t flag = uint32_t{1} << bit;
+    if ((raised & flag) != 0u) {
+      ESP_LOGW(TAG, "Fault raised: %s (bit %u)", error_flag_name(bit), bit);
+      this->fault_raised_trigger_.trigger(bit);
+    } else if ((cleared & flag) != 0u) {
+      ESP_LOGI(TAG, "Fault cleared: %s (bit %u)", error_flag_name(bit), bit);
+      this->fault_cleared_trigger_.trigger(bit);
+    }
+  }
 }
 
 // When a write command fails we re-request the value so the UI reflects the
@@ -1536,25 +3349,7 @@ void ESP32EVSEComponent::update_error_flags_(uint32_t mask) {
 void ESP32EVSEComponent::request_number_update_(ESP32EVSEChargingCurrentNumber *number) {
   if (number == nullptr)
     return;
-  if (number == this->charging_current_number_) {
-    this->request_charging_current_update();
-  } else if (number == this->default_charging_current_number_) {
-    this->request_default_charging_current_update();
-  } else if (number == this->maximum_charging_current_number_) {
-    this->request_maximum_charging_current_update();
-  } else if (number == this->consumption_limit_number_) {
-    this->request_consumption_limit_update();
-  } else if (number == this->default_consumption_limit_number_) {
-    this->request_default_consumption_limit_update();
-  } else if (number == this->charging_time_limit_number_) {
-    this->request_charging_time_limit_update();
-  } else if (number == this->default_charging_time_limit_number_) {
-    this->request_default_charging_time_limit_update();
-  } else if (number == this->under_power_limit_number_) {
-    this->request_under_power_limit_update();
-  } else if (number == this->default_under_power_limit_number_) {
-    this->request_default_under_power_limit_update();
-  }
+  this->request_slot_update(number->get_slot());
 }
 
 void ESP32EVSEEnableSwitch::write_state(bool state) {
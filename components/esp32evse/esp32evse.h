@@ -13,317 +13,550 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/entity_base.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/preferences.h"
 
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
+
+// Capacity of the pending command queue.  The Python glue emits this from the
+// ``command_queue_size`` option; the fallback matches the historic fixed size.
+#ifndef ESP32EVSE_COMMAND_QUEUE_SIZE
+#define ESP32EVSE_COMMAND_QUEUE_SIZE 48
+#endif
 
 namespace esphome {
 namespace esp32evse {
 
-class ESP32EVSEEnableSwitch;
-class ESP32EVSEAvailableSwitch;
-class ESP32EVSERequestAuthorizationSwitch;
-class ESP32EVSEEmeterThreePhaseSwitch;
 class ESP32EVSEChargingCurrentNumber;
-class ESP32EVSEResetButton;
-class ESP32EVSEAuthorizeButton;
-class ESP32EVSEStartAccessPointButton;
-class ESP32EVSEPendingAuthorizationBinarySensor;
-class ESP32EVSEWifiConnectedBinarySensor;
-class ESP32EVSEChargingLimitReachedBinarySensor;
-class ESP32EVSEPilotFaultBinarySensor;
-class ESP32EVSEDiodeShortBinarySensor;
-class ESP32EVSELockFaultBinarySensor;
-class ESP32EVSEUnlockFaultBinarySensor;
-class ESP32EVSERCMTriggeredBinarySensor;
-class ESP32EVSERCMSelfTestFaultBinarySensor;
-class ESP32EVSETemperatureHighFaultBinarySensor;
-class ESP32EVSETemperatureFaultBinarySensor;
-class ESP32EVSETimeoutFaultBinarySensor;
+class ESP32EVSEOptimisticEntity;
 
 template<typename... Ts>
 class ESP32EVSEManagedSubscriptionAction;
 template<typename... Ts>
 class ESP32EVSEUnsubscribeAllAction;
 
+#ifdef USE_ESP32EVSE_TELEMETRY
+// Series kept by the telemetry log.  Values are stored in the integer units the
+// EVSE reports: W, mV, mA and hundredths of a degree Celsius.
+enum class TelemetryChannel : uint8_t {
+  POWER,
+  VOLTAGE_L1,
+  VOLTAGE_L2,
+  VOLTAGE_L3,
+  CURRENT_L1,
+  CURRENT_L2,
+  CURRENT_L3,
+  TEMPERATURE_HIGH,
+  TEMPERATURE_LOW,
+};
+static constexpr uint8_t TELEMETRY_CHANNEL_COUNT = 9;
+
+// Fixed-size time-series store for the fast EVSE streams.  The buffer is cut
+// into 64 byte blocks; each block belongs to one channel and holds a first
+// sample followed by varint-encoded deltas (delta-of-delta for the timestamp,
+// delta for the value), so steady readings cost 2-4 bytes each.  Blocks are
+// reused oldest-first once the buffer is full.  Samples are decimated to at
+// most one per ``interval``, averaging whatever arrived in between.
+class TelemetryLog {
+ public:
+  static constexpr size_t BLOCK_SIZE = 64;
+
+  void init(size_t buffer_bytes, uint32_t interval_ms);
+  bool is_enabled() const { return !this->blocks_.empty(); }
+  void record(TelemetryChannel channel, int32_t value, uint32_t now);
+  // Calls ``callback(timestamp_ms, value)`` oldest first for every stored
+  // sample of ``channel`` no older than ``window_ms`` (0 means everything).
+  void for_each(TelemetryChannel channel, uint32_t window_ms, uint32_t now,
+                const std::function<void(uint32_t, int32_t)> &callback) const;
+
+  size_t get_buffer_size() const { return this->blocks_.size() * BLOCK_SIZE; }
+  uint32_t get_interval() const { return this->interval_ms_; }
+  uint32_t get_sample_count() const;
+
+ protected:
+  static constexpr uint8_t CHANNEL_FREE = 0xFF;
+  static constexpr uint16_t NO_BLOCK = 0xFFFF;
+  static constexpr size_t PAYLOAD_SIZE = BLOCK_SIZE - 12;
+
+  struct Block {
+    uint32_t start_ms{0};
+    int32_t start_value{0};
+    uint8_t channel{CHANNEL_FREE};
+    uint8_t count{0};  // samples stored after the first one
+    uint8_t used{0};   // payload bytes in use
+    uint8_t reserved{0};
+    uint8_t payload[PAYLOAD_SIZE]{};
+  };
+  static_assert(sizeof(Block) == BLOCK_SIZE, "telemetry blocks must stay 64 bytes");
+
+  // Encoder and decimation state of one channel.
+  struct Writer {
+    uint16_t block{NO_BLOCK};
+    uint32_t last_ms{0};
+    uint32_t last_dt{0};
+    int32_t last_value{0};
+    bool has_sample{false};
+    int64_t pending_sum{0};
+    uint16_t pending_count{0};
+  };
+
+  void append_(TelemetryChannel channel, int32_t value, uint32_t now);
+  uint16_t open_block_(uint8_t channel, int32_t value, uint32_t now);
+
+  std::vector<Block> blocks_;
+  uint16_t next_block_{0};
+  uint32_t interval_ms_{0};
+  std::array<Writer, TELEMETRY_CHANNEL_COUNT> writers_{};
+};
+#endif
+
 // Main component class that orchestrates communication with the EVSE controller
 // and fans out the resulting state to the various ESPHome entities registered
 // through the Python glue code.
 class ESP32EVSEComponent : public uart::UARTDevice, public PollingComponent {
  public:
-  ESP32EVSEComponent() : PollingComponent(60000) {}
+  ESP32EVSEComponent() : PollingComponent(60000) { this->entity_index_.fill(NO_ENTITY); }
   void setup() override;
   void loop() override;
   void dump_config() override;
   void update() override;
   void force_update();
 
-  // The following setter helpers are invoked from the Python glue code to
-  // connect ESPHome entities to this component instance.  Storing the pointers
-  // allows the C++ implementation to publish updates when data arrives from the
-  // EVSE over UART.
-  void set_state_text_sensor(text_sensor::TextSensor *sensor) { this->state_text_sensor_ = sensor; }
-  void set_chip_text_sensor(text_sensor::TextSensor *sensor) { this->chip_text_sensor_ = sensor; }
-  void set_version_text_sensor(text_sensor::TextSensor *sensor) { this->version_text_sensor_ = sensor; }
-  void set_idf_version_text_sensor(text_sensor::TextSensor *sensor) {
-    this->idf_version_text_sensor_ = sensor;
-  }
-  void set_build_time_text_sensor(text_sensor::TextSensor *sensor) {
-    this->build_time_text_sensor_ = sensor;
-  }
-  void set_device_time_text_sensor(text_sensor::TextSensor *sensor) {
-    this->device_time_text_sensor_ = sensor;
-  }
-  void set_wifi_sta_ssid_text_sensor(text_sensor::TextSensor *sensor) {
-    this->wifi_sta_ssid_text_sensor_ = sensor;
-  }
-  void set_wifi_sta_ip_text_sensor(text_sensor::TextSensor *sensor) {
-    this->wifi_sta_ip_text_sensor_ = sensor;
-  }
-  void set_wifi_sta_mac_text_sensor(text_sensor::TextSensor *sensor) {
-    this->wifi_sta_mac_text_sensor_ = sensor;
-  }
-  void set_device_name_text_sensor(text_sensor::TextSensor *sensor) {
-    this->device_name_text_sensor_ = sensor;
-  }
-
-  void set_enable_switch(ESP32EVSEEnableSwitch *sw) { this->enable_switch_ = sw; }
-  void set_available_switch(ESP32EVSEAvailableSwitch *sw) { this->available_switch_ = sw; }
-  void set_request_authorization_switch(ESP32EVSERequestAuthorizationSwitch *sw) {
-    this->request_authorization_switch_ = sw;
-  }
-  void set_emeter_three_phase_switch(ESP32EVSEEmeterThreePhaseSwitch *sw) {
-    this->emeter_three_phase_switch_ = sw;
-  }
-
-  void set_temperature_high_sensor(sensor::Sensor *sensor) {
-    this->temperature_high_sensor_ = sensor;
-  }
-  void set_temperature_low_sensor(sensor::Sensor *sensor) {
-    this->temperature_low_sensor_ = sensor;
-  }
-  void set_temperature_sensor(sensor::Sensor *sensor) { this->set_temperature_high_sensor(sensor); }
-  void set_heap_used_sensor(sensor::Sensor *sensor) { this->heap_used_sensor_ = sensor; }
-  void set_heap_total_sensor(sensor::Sensor *sensor) { this->heap_total_sensor_ = sensor; }
-  void set_energy_consumption_sensor(sensor::Sensor *sensor) {
-    this->energy_consumption_sensor_ = sensor;
-  }
-  void set_total_energy_consumption_sensor(sensor::Sensor *sensor) {
-    this->total_energy_consumption_sensor_ = sensor;
-  }
-  void set_voltage_l1_sensor(sensor::Sensor *sensor) { this->voltage_l1_sensor_ = sensor; }
-  void set_voltage_l2_sensor(sensor::Sensor *sensor) { this->voltage_l2_sensor_ = sensor; }
-  void set_voltage_l3_sensor(sensor::Sensor *sensor) { this->voltage_l3_sensor_ = sensor; }
-  void set_current_l1_sensor(sensor::Sensor *sensor) { this->current_l1_sensor_ = sensor; }
-  void set_current_l2_sensor(sensor::Sensor *sensor) { this->current_l2_sensor_ = sensor; }
-  void set_current_l3_sensor(sensor::Sensor *sensor) { this->current_l3_sensor_ = sensor; }
-  void set_wifi_rssi_sensor(sensor::Sensor *sensor) { this->wifi_rssi_sensor_ = sensor; }
-
-  void set_charging_current_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->charging_current_number_ = number;
-  }
-  void set_default_charging_current_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->default_charging_current_number_ = number;
-  }
-  void set_maximum_charging_current_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->maximum_charging_current_number_ = number;
-  }
-  void set_consumption_limit_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->consumption_limit_number_ = number;
-  }
-  void set_default_consumption_limit_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->default_consumption_limit_number_ = number;
-  }
-  void set_charging_time_limit_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->charging_time_limit_number_ = number;
-  }
-  void set_default_charging_time_limit_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->default_charging_time_limit_number_ = number;
-  }
-  void set_under_power_limit_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->under_power_limit_number_ = number;
-  }
-  void set_default_under_power_limit_number(ESP32EVSEChargingCurrentNumber *number) {
-    this->default_under_power_limit_number_ = number;
-  }
-
-  float clamp_charging_current_value(ESP32EVSEChargingCurrentNumber *number, float value) const;
-
-  Trigger<> *get_ready_trigger() { return &this->ready_trigger_; }
-
-  void set_emeter_power_sensor(sensor::Sensor *sensor) { this->emeter_power_sensor_ = sensor; }
-  void set_emeter_session_time_sensor(sensor::Sensor *sensor) {
-    this->emeter_session_time_sensor_ = sensor;
-  }
-  void set_emeter_charging_time_sensor(sensor::Sensor *sensor) {
-    this->emeter_charging_time_sensor_ = sensor;
-  }
-  void set_uptime_sensor(sensor::Sensor *sensor) { this->uptime_sensor_ = sensor; }
-
-  void set_reset_button(ESP32EVSEResetButton *btn) { this->reset_button_ = btn; }
-  void set_authorize_button(ESP32EVSEAuthorizeButton *btn) { this->authorize_button_ = btn; }
-  void set_start_ap_button(ESP32EVSEStartAccessPointButton *btn) { this->start_ap_button_ = btn; }
-
-  void set_pending_authorization_binary_sensor(ESP32EVSEPendingAuthorizationBinarySensor *bs) {
-    this->pending_authorization_binary_sensor_ = bs;
-  }
-  void set_wifi_connected_binary_sensor(ESP32EVSEWifiConnectedBinarySensor *bs) {
-    this->wifi_connected_binary_sensor_ = bs;
-  }
-  void set_charging_limit_reached_binary_sensor(
-      ESP32EVSEChargingLimitReachedBinarySensor *bs) {
-    this->charging_limit_reached_binary_sensor_ = bs;
-  }
-  void set_pilot_fault_binary_sensor(ESP32EVSEPilotFaultBinarySensor *bs) {
-    this->pilot_fault_binary_sensor_ = bs;
-  }
-  void set_diode_short_binary_sensor(ESP32EVSEDiodeShortBinarySensor *bs) {
-    this->diode_short_binary_sensor_ = bs;
-  }
-  void set_lock_fault_binary_sensor(ESP32EVSELockFaultBinarySensor *bs) {
-    this->lock_fault_binary_sensor_ = bs;
-  }
-  void set_unlock_fault_binary_sensor(ESP32EVSEUnlockFaultBinarySensor *bs) {
-    this->unlock_fault_binary_sensor_ = bs;
-  }
-  void set_rcm_triggered_binary_sensor(ESP32EVSERCMTriggeredBinarySensor *bs) {
-    this->rcm_triggered_binary_sensor_ = bs;
-  }
-  void set_rcm_self_test_fault_binary_sensor(ESP32EVSERCMSelfTestFaultBinarySensor *bs) {
-    this->rcm_self_test_fault_binary_sensor_ = bs;
-  }
-  void set_temperature_high_fault_binary_sensor(ESP32EVSETemperatureHighFaultBinarySensor *bs) {
-    this->temperature_high_fault_binary_sensor_ = bs;
-  }
-  void set_temperature_fault_binary_sensor(ESP32EVSETemperatureFaultBinarySensor *bs) {
-    this->temperature_fault_binary_sensor_ = bs;
-  }
-  void set_timeout_fault_binary_sensor(ESP32EVSETimeoutFaultBinarySensor *bs) {
-    this->timeout_fault_binary_sensor_ = bs;
-  }
-
-  // Methods that enqueue UART requests to refresh EVSE state.  These are called
-  // during setup and from entity actions (for example, when a user toggles a
-  // switch) so the ESPHome representation stays in sync with the charger.
-  void request_state_update();
-  void request_enable_update();
-  void request_temperature_update();
-  void request_charging_current_update();
-  void request_emeter_power_update();
-  void request_emeter_session_time_update();
-  void request_emeter_charging_time_update();
-  void request_uptime_update();
-  void request_chip_update();
-  void request_version_update();
-  void request_idf_version_update();
-  void request_build_time_update();
-  void request_device_time_update();
-  void request_wifi_sta_cfg_update();
-  void request_wifi_sta_ip_update();
-  void request_wifi_sta_mac_update();
-  void request_device_name_update();
-  void request_available_update();
-  void request_request_authorization_update();
-  void request_emeter_three_phase_update();
-  void request_heap_update();
-  void request_energy_consumption_update();
-  void request_total_energy_consumption_update();
-  void request_voltage_update();
-  void request_current_update();
-  void request_wifi_status_update();
-  void request_default_charging_current_update();
-  void request_maximum_charging_current_update();
-  void request_consumption_limit_update();
-  void request_default_consumption_limit_update();
-  void request_charging_time_limit_update();
-  void request_default_charging_time_limit_update();
-  void request_under_power_limit_update();
-  void request_default_under_power_limit_update();
-  void request_pending_authorization_update();
-  void request_charging_limit_reached_update();
-  void request_error_flags_update();
-
-  // Writers mirror user initiated actions back to the EVSE controller.
-  void write_enable_state(bool enabled);
-  void write_available_state(bool available);
-  void write_request_authorization_state(bool request);
-  void write_emeter_three_phase_state(bool enabled);
-  void write_charging_current(float current);
-  void write_number_value(ESP32EVSEChargingCurrentNumber *number, float value);
-
-  // Helpers for managing optional high-frequency subscriptions exposed by the
-  // EVSE firmware (for example, power telemetry feeds).
-  void at_sub(const std::string &command, uint32_t period_ms);
-  void at_unsub(const std::string &command = "");
-  void send_reset_command();
-  void send_authorize_command();
-  void send_start_ap_command();
-
- protected:
-  void perform_update_(bool force);
-  static constexpr uint32_t ERROR_FLAG_PILOT_FAULT = 1u << 0;
-  static constexpr uint32_t ERROR_FLAG_DIODE_SHORT = 1u << 1;
-  static constexpr uint32_t ERROR_FLAG_LOCK_FAULT = 1u << 2;
-  static constexpr uint32_t ERROR_FLAG_UNLOCK_FAULT = 1u << 3;
-  static constexpr uint32_t ERROR_FLAG_RCM_TRIGGERED = 1u << 4;
-  static constexpr uint32_t ERROR_FLAG_RCM_SELF_TEST_FAULT = 1u << 5;
-  static constexpr uint32_t ERROR_FLAG_TEMPERATURE_HIGH = 1u << 6;
-  static constexpr uint32_t ERROR_FLAG_TEMPERATURE_FAULT = 1u << 7;
+  // Maximum number of AT commands sent before their ACKs arrive.  ``1`` keeps
+  // the classic stop-and-wait behaviour.
+  void set_command_window(uint8_t window) { this->command_window_ = window == 0 ? 1 : window; }
 
   // Every high-frequency query is assigned a "freshness slot".  The slot holds
   // the timestamp of the most recent response so the periodic poll can tell if
   // we already have up-to-date data without re-issuing the corresponding AT
-  // command.
+  // command.  Slots are listed in the order they are queried.
   enum class FreshnessSlot : uint8_t {
     STATE = 0,
     ENABLE,
     PENDING_AUTHORIZATION,
     ERROR_FLAGS,
-    TEMPERATURE,
     CHARGING_CURRENT,
+    AVAILABLE,
+    REQUEST_AUTHORIZATION,
     EMETER_POWER,
+    VOLTAGE,
+    CURRENT,
+    TEMPERATURE,
     EMETER_SESSION_TIME,
     EMETER_CHARGING_TIME,
-    UPTIME,
-    HEAP,
     ENERGY_CONSUMPTION,
     TOTAL_ENERGY_CONSUMPTION,
-    VOLTAGE,
-    CURRENT,
-    WIFI_STATUS,
-    AVAILABLE,
-    REQUEST_AUTHORIZATION,
     CHARGING_LIMIT_REACHED,
+    WIFI_STATUS,
+    HEAP,
+    UPTIME,
     EMETER_THREE_PHASE,
-    DEFAULT_CHARGING_CURRENT,
     MAXIMUM_CHARGING_CURRENT,
+    DEFAULT_CHARGING_CURRENT,
     CONSUMPTION_LIMIT,
     DEFAULT_CONSUMPTION_LIMIT,
     CHARGING_TIME_LIMIT,
     DEFAULT_CHARGING_TIME_LIMIT,
     UNDER_POWER_LIMIT,
     DEFAULT_UNDER_POWER_LIMIT,
+    CHIP,
+    VERSION,
+    IDF_VERSION,
+    BUILD_TIME,
+    DEVICE_TIME,
     WIFI_STA_CFG,
     WIFI_STA_IP,
     WIFI_STA_MAC,
     DEVICE_NAME,
+    SLOT_COUNT
+  };
+
+  // Poll interval sentinels: ``POLL_EVERY_UPDATE`` follows ``update_interval``
+  // and ``POLL_ONCE`` queries the slot once after every EVSE boot.  Any other
+  // value is a minimum spacing in milliseconds between polls of that slot.
+  static constexpr uint32_t POLL_EVERY_UPDATE = 0;
+  static constexpr uint32_t POLL_ONCE = std::numeric_limits<uint32_t>::max();
+  // Override the built-in interval of a slot.  Entities sharing a slot may each
+  // request one; the most frequent request wins.
+  void set_poll_interval(FreshnessSlot slot, uint32_t interval_ms);
+  // Poll a slot on every update and during startup.  The Python glue calls
+  // this for each configured entity; C++ consumers such as
+  // ``ESP32EVSECoordinator`` call it for slots they read without an entity.
+  void require_slot(FreshnessSlot slot) { this->polled_slots_ |= slot_bit_(slot); }
+
+  // Latest meter readings in the units the EVSE reports.  Each field stays
+  // empty until its first response arrives.
+  struct MeterReadings {
+    std::optional<uint32_t> power_w;
+    std::optional<std::array<int64_t, 3>> current_ma;
+    std::optional<int64_t> energy_wh;
+    std::optional<int64_t> total_energy_wh;
+  };
+  const MeterReadings &get_meter_readings() const { return this->meter_readings_; }
+
+  // Health of the UART link.  ``DEGRADED`` follows a command timeout and
+  // limits the link to one command in flight; after repeated timeouts the link
+  // is ``DOWN``: queued commands are failed, new ones are refused and the EVSE
+  // is probed with a plain ``AT`` at increasing intervals until it answers.
+  enum class LinkState : uint8_t { UP = 0, DEGRADED, DOWN };
+  LinkState get_link_state() const { return this->link_state_; }
+  // Current command timeout, derived from the measured round-trip times.
+  uint32_t get_command_timeout() const { return this->command_timeout_ms_; }
+
+  // Command latency statistics.  Round trips (send to OK/ERROR) are kept per
+  // class of command, plus one histogram of the time commands wait in the
+  // queue before they are sent.
+  enum class CommandClass : uint8_t { QUERY = 0, WRITE, SUBSCRIBE };
+  static constexpr size_t COMMAND_CLASS_COUNT = 3;
+
+  // Millisecond histogram with fixed power-of-two buckets: ``[0, 1)``,
+  // ``[1, 2)``, ``[2, 4)`` ... ``[2048, 4096)`` and ``[4096, inf)``.
+  struct LatencyHistogram {
+    static constexpr size_t BUCKETS = 14;
+    std::array<uint32_t, BUCKETS> counts{};
+    uint32_t samples{0};
+    uint32_t max_ms{0};
+    uint64_t total_ms{0};
+    // Commands of this class that never got an answer.
+    uint32_t timeouts{0};
+
+    static size_t bucket_for(uint32_t ms);
+    void record(uint32_t ms);
+    uint32_t mean() const { return this->samples == 0 ? 0 : static_cast<uint32_t>(this->total_ms / this->samples); }
+    // Estimate interpolated within the bucket that holds the percentile.
+    uint32_t percentile(uint8_t percent) const;
+  };
+  const LatencyHistogram &get_round_trip_histogram(CommandClass command_class) const {
+    return this->round_trip_histograms_[static_cast<size_t>(command_class)];
+  }
+  const LatencyHistogram &get_queue_wait_histogram() const { return this->queue_wait_histogram_; }
+
+  // Scheduling classes of the command queue, most urgent first.  A command is
+  // queued behind everything of its own or a more urgent class and overtakes
+  // the rest, unless those have waited longer than their class allows; aged
+  // commands are not overtaken any more, which bounds every class's wait.
+  enum class CommandPriority : uint8_t {
+    // ``AT+ERROR?`` and the link probe.
+    SAFETY = 0,
+    // Switch and number writes, buttons, raw commands and ``at_sub``.
+    USER,
+    // Control and telemetry polls and subscription upkeep.
+    CONTROL,
+    // Settings and identity polls.
+    BACKGROUND,
+  };
+  static constexpr size_t COMMAND_PRIORITY_COUNT = 4;
+  // Time commands of one class waited in the queue before they were sent.
+  const LatencyHistogram &get_queue_wait_histogram(CommandPriority priority) const {
+    return this->priority_wait_histograms_[static_cast<size_t>(priority)];
+  }
+  // Largest number of commands the queue has held at once.
+  size_t get_queue_high_water_mark() const { return this->queue_high_water_mark_; }
+
+  // Every entity the component can publish to, grouped by kind.  The Python
+  // platforms register the configured ones with ``register_entity``, using the
+  // same names; an entity that is not configured costs one byte.
+  enum class EntityId : uint8_t {
+    // Text sensors.
+    STATE = 0,
     CHIP,
     VERSION,
     IDF_VERSION,
     BUILD_TIME,
     DEVICE_TIME,
-    SLOT_COUNT
+    WIFI_STA_SSID,
+    WIFI_STA_IP,
+    WIFI_STA_MAC,
+    DEVICE_NAME,
+    LINK_STATE,
+    // Switches.
+    ENABLE,
+    AVAILABLE,
+    REQUEST_AUTHORIZATION,
+    EMETER_THREE_PHASE,
+    // Sensors.
+    TEMPERATURE_HIGH,
+    TEMPERATURE_LOW,
+    EMETER_POWER,
+    EMETER_SESSION_TIME,
+    EMETER_CHARGING_TIME,
+    UPTIME,
+    HEAP_USED,
+    HEAP_TOTAL,
+    ENERGY_CONSUMPTION,
+    TOTAL_ENERGY_CONSUMPTION,
+    // Session energy integrated locally from ``+EMETERPOWER`` and anchored to
+    // every new ``+EMETERCONSUM``; smooth as long as the power is subscribed.
+    SESSION_ENERGY,
+    VOLTAGE_L1,
+    VOLTAGE_L2,
+    VOLTAGE_L3,
+    CURRENT_L1,
+    CURRENT_L2,
+    CURRENT_L3,
+    WIFI_RSSI,
+    // The raw ``+ERROR`` mask, including bits without a binary sensor of their
+    // own.
+    ERROR_MASK,
+    // Diagnostics published on every update.  Latencies are the 95th
+    // percentile since boot.
+    QUERY_LATENCY,
+    WRITE_LATENCY,
+    SUBSCRIBE_LATENCY,
+    QUEUE_WAIT,
+    QUEUE_HIGH_WATER,
+    DROPPED_COMMANDS,
+    TIME_TO_FIRST_STATE,
+    // Numbers.
+    CHARGING_CURRENT,
+    DEFAULT_CHARGING_CURRENT,
+    MAXIMUM_CHARGING_CURRENT,
+    CONSUMPTION_LIMIT,
+    DEFAULT_CONSUMPTION_LIMIT,
+    CHARGING_TIME_LIMIT,
+    DEFAULT_CHARGING_TIME_LIMIT,
+    UNDER_POWER_LIMIT,
+    DEFAULT_UNDER_POWER_LIMIT,
+    // Binary sensors.
+    PENDING_AUTHORIZATION,
+    CHARGING_LIMIT_REACHED,
+    WIFI_CONNECTED,
+    PILOT_FAULT,
+    DIODE_SHORT,
+    LOCK_FAULT,
+    UNLOCK_FAULT,
+    RCM_TRIGGERED,
+    RCM_SELF_TEST_FAULT,
+    TEMPERATURE_HIGH_FAULT,
+    TEMPERATURE_FAULT,
+    TIMEOUT_FAULT,
+    // On from boot until the component is state ready.  While it is on, the
+    // entities may show values restored from the warm-start snapshot.
+    STALE_DATA,
+    ENTITY_COUNT,
+    // ``SLOT_QUERIES`` entry without an entity of its own.
+    NONE = ENTITY_COUNT,
+  };
+  // Attach a configured entity.  The type behind ``entity`` must match the
+  // kind of ``id``; switches and numbers are this component's own classes.
+  void register_entity(EntityId id, EntityBase *entity);
+
+  float clamp_charging_current_value(ESP32EVSEChargingCurrentNumber *number, float value) const;
+
+  // Number of commands rejected because the pending command queue was full.
+  uint32_t get_dropped_command_count() const { return this->dropped_commands_; }
+  // Number of commands folded into an identical query or superseded write that
+  // was still waiting in the queue.
+  uint32_t get_merged_command_count() const { return this->merged_commands_; }
+
+  // Per-entity publish filter applied before ``publish_state`` (and therefore
+  // before the ESPHome filter chain).  A value is dropped when it arrives
+  // within ``min_interval_ms`` of the last published one, or when it differs
+  // from it by no more than ``delta`` (a fraction of the last value when
+  // ``relative``).  With ``only_on_change`` exact repeats are dropped even for
+  // a zero ``delta``.  Switches, binary sensors and numbers default to
+  // change-only; sensors publish everything unless configured.  Applies to
+  // an entity already passed to ``register_entity``.
+  void set_publish_filter(EntityBase *entity, float delta, bool relative, uint32_t min_interval_ms,
+                          bool only_on_change);
+  // Number of entity updates dropped by the publish filters.
+  uint32_t get_suppressed_publish_count() const { return this->suppressed_publishes_; }
+
+#ifdef USE_ESP32EVSE_TELEMETRY
+  // Keep a ``buffer_bytes`` time-series of the channels in ``channel_mask``
+  // (bit ``1 << TelemetryChannel``), at most one sample per ``interval_ms``.
+  // The buffer is allocated once in ``setup()``.
+  void set_telemetry(size_t buffer_bytes, uint32_t interval_ms, uint16_t channel_mask);
+  // Stored samples of ``channel`` from the last ``window_ms`` (0 for all),
+  // oldest first, as ``millis()`` timestamps and values in W, V, A or °C.
+  void for_each_telemetry_sample(TelemetryChannel channel, uint32_t window_ms,
+                                 const std::function<void(uint32_t, float)> &callback) const;
+  // Log the samples of the channels in ``channel_mask`` from the last
+  // ``window_ms``.  The output is spread over the following ``loop()`` calls;
+  // a new request replaces one still in progress.
+  void dump_telemetry(uint32_t window_ms, uint16_t channel_mask);
+  const TelemetryLog &get_telemetry() const { return this->telemetry_; }
+#endif
+
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+  // Dynamic load management without a round trip through Home Assistant.  The
+  // grid sensors measure each phase at the supply, charger included; the
+  // charger's own ``+EMETERCURRENT`` is subtracted to get the rest of the
+  // house, and ``charging_current`` is kept within what the fuse leaves.
+  // When a phase exceeds the fuse limit the current is lowered with the same
+  // grid sample; increases need ``hysteresis`` amps of headroom and
+  // ``min_change_interval_ms`` since the last change.  Without a fresh sample from every grid sensor for
+  // ``timeout_ms``, the charger falls back to ``failsafe_current``.
+  void set_grid_current_sensor(uint8_t phase, sensor::Sensor *sensor) { this->grid_current_sensors_[phase] = sensor; }
+  void set_load_management(float fuse_limit, float hysteresis, uint32_t min_change_interval_ms, uint32_t timeout_ms,
+                           float failsafe_current);
+  enum class LoadManagementState : uint8_t { WAITING = 0, ACTIVE, FAILSAFE };
+  LoadManagementState get_load_management_state() const { return this->load_management_state_; }
+  // Charging current the controller last asked for, in amps.
+  float get_load_management_target() const { return this->load_management_target_tenths_ * 0.1f; }
+  // Time from the grid sample behind the last write to the EVSE's ``OK``.
+  uint32_t get_load_management_reaction_time() const { return this->load_management_reaction_ms_; }
+#endif
+
+  Trigger<> *get_ready_trigger() { return &this->ready_trigger_; }
+
+  // Startup is staged: control data first, then telemetry, settings and
+  // identity.  The component counts as "state ready" once the control stage
+  // has been answered and ``+STATE`` is known; that moment, in milliseconds
+  // since boot, is the time to first state.
+  bool is_state_ready() const { return this->state_ready_; }
+  uint32_t get_time_to_first_state() const { return this->time_to_first_state_ms_; }
+  Trigger<> *get_state_ready_trigger() { return &this->state_ready_trigger_; }
+
+#ifdef USE_ESP32EVSE_WARM_START
+  // Persist the last known state and identity strings through ESPHome
+  // preferences, at most once per ``save_interval_ms`` and only when they
+  // changed.  The snapshot is published right at boot, and the chip, IDF
+  // version and MAC queries are skipped while ``+VER`` and ``+BUILDTIME``
+  // still match it.  ``key`` keeps the snapshots of several chargers apart.
+  void set_warm_start(uint32_t save_interval_ms, const std::string &key);
+#endif
+
+  // Last ``+ERROR`` mask, see the ``ERROR_FLAG_*`` bits.
+  uint32_t get_error_flags() const { return this->error_flags_; }
+  // Fire once per ``+ERROR`` bit that turns on or off, with the bit index.
+  Trigger<uint8_t> *get_fault_raised_trigger() { return &this->fault_raised_trigger_; }
+  Trigger<uint8_t> *get_fault_cleared_trigger() { return &this->fault_cleared_trigger_; }
+
+  // Methods that enqueue UART requests to refresh EVSE state.  These are called
+  // during setup and from entity actions (for example, when a user toggles a
+  // switch) so the ESPHome representation stays in sync with the charger.
+  // Each one sends the query of its freshness slot.
+  void request_slot_update(FreshnessSlot slot);
+  void request_state_update() { this->request_slot_update(FreshnessSlot::STATE); }
+  void request_enable_update() { this->request_slot_update(FreshnessSlot::ENABLE); }
+  void request_temperature_update() { this->request_slot_update(FreshnessSlot::TEMPERATURE); }
+  void request_charging_current_update() { this->request_slot_update(FreshnessSlot::CHARGING_CURRENT); }
+  void request_emeter_power_update() { this->request_slot_update(FreshnessSlot::EMETER_POWER); }
+  void request_emeter_session_time_update() { this->request_slot_update(FreshnessSlot::EMETER_SESSION_TIME); }
+  void request_emeter_charging_time_update() { this->request_slot_update(FreshnessSlot::EMETER_CHARGING_TIME); }
+  void request_uptime_update() { this->request_slot_update(FreshnessSlot::UPTIME); }
+  void request_chip_update() { this->request_slot_update(FreshnessSlot::CHIP); }
+  void request_version_update() { this->request_slot_update(FreshnessSlot::VERSION); }
+  void request_idf_version_update() { this->request_slot_update(FreshnessSlot::IDF_VERSION); }
+  void request_build_time_update() { this->request_slot_update(FreshnessSlot::BUILD_TIME); }
+  void request_device_time_update() { this->request_slot_update(FreshnessSlot::DEVICE_TIME); }
+  void request_wifi_sta_cfg_update() { this->request_slot_update(FreshnessSlot::WIFI_STA_CFG); }
+  void request_wifi_sta_ip_update() { this->request_slot_update(FreshnessSlot::WIFI_STA_IP); }
+  void request_wifi_sta_mac_update() { this->request_slot_update(FreshnessSlot::WIFI_STA_MAC); }
+  void request_device_name_update() { this->request_slot_update(FreshnessSlot::DEVICE_NAME); }
+  void request_available_update() { this->request_slot_update(FreshnessSlot::AVAILABLE); }
+  void request_request_authorization_update() { this->request_slot_update(FreshnessSlot::REQUEST_AUTHORIZATION); }
+  void request_emeter_three_phase_update() { this->request_slot_update(FreshnessSlot::EMETER_THREE_PHASE); }
+  void request_heap_update() { this->request_slot_update(FreshnessSlot::HEAP); }
+  void request_energy_consumption_update() { this->request_slot_update(FreshnessSlot::ENERGY_CONSUMPTION); }
+  void request_total_energy_consumption_update() { this->request_slot_update(FreshnessSlot::TOTAL_ENERGY_CONSUMPTION); }
+  void request_voltage_update() { this->request_slot_update(FreshnessSlot::VOLTAGE); }
+  void request_current_update() { this->request_slot_update(FreshnessSlot::CURRENT); }
+  void request_wifi_status_update() { this->request_slot_update(FreshnessSlot::WIFI_STATUS); }
+  void request_default_charging_current_update() { this->request_slot_update(FreshnessSlot::DEFAULT_CHARGING_CURRENT); }
+  void request_maximum_charging_current_update() { this->request_slot_update(FreshnessSlot::MAXIMUM_CHARGING_CURRENT); }
+  void request_consumption_limit_update() { this->request_slot_update(FreshnessSlot::CONSUMPTION_LIMIT); }
+  void request_default_consumption_limit_update() {
+    this->request_slot_update(FreshnessSlot::DEFAULT_CONSUMPTION_LIMIT);
+  }
+  void request_charging_time_limit_update() { this->request_slot_update(FreshnessSlot::CHARGING_TIME_LIMIT); }
+  void request_default_charging_time_limit_update() {
+    this->request_slot_update(FreshnessSlot::DEFAULT_CHARGING_TIME_LIMIT);
+  }
+  void request_under_power_limit_update() { this->request_slot_update(FreshnessSlot::UNDER_POWER_LIMIT); }
+  void request_default_under_power_limit_update() {
+    this->request_slot_update(FreshnessSlot::DEFAULT_UNDER_POWER_LIMIT);
+  }
+  void request_pending_authorization_update() { this->request_slot_update(FreshnessSlot::PENDING_AUTHORIZATION); }
+  void request_charging_limit_reached_update() { this->request_slot_update(FreshnessSlot::CHARGING_LIMIT_REACHED); }
+  void request_error_flags_update() { this->request_slot_update(FreshnessSlot::ERROR_FLAGS); }
+
+  // What an ``esp32evse.write`` action writes.
+  enum class WriteTarget : uint8_t {
+    ENABLE = 0,
+    AVAILABLE,
+    REQUEST_AUTHORIZATION,
+    EMETER_THREE_PHASE,
+    CHARGING_CURRENT,
+    NUMBER,
   };
+  // Called once a write is finished.  ``success`` is ``false`` on ``ERROR``, on
+  // a timeout and when the write could not be queued; ``latency_ms`` runs from
+  // queueing to the acknowledgement.
+  using WriteCallback = std::function<void(bool success, uint32_t latency_ms)>;
+
+  // Writers mirror user initiated actions back to the EVSE controller.  They
+  // return ``false`` when the command could not be queued (invalid argument or
+  // the pending command queue is full).  ``callback`` runs exactly once, also
+  // when ``false`` is returned.  A write superseded by a newer one to the same
+  // entity reports the outcome of the newer write.
+  bool write_enable_state(bool enabled, WriteCallback callback = nullptr);
+  bool write_available_state(bool available, WriteCallback callback = nullptr);
+  bool write_request_authorization_state(bool request, WriteCallback callback = nullptr);
+  bool write_emeter_three_phase_state(bool enabled, WriteCallback callback = nullptr);
+  bool write_charging_current(float current, WriteCallback callback = nullptr);
+  bool write_number_value(ESP32EVSEChargingCurrentNumber *number, float value, WriteCallback callback = nullptr);
+  // Fire for every finished switch or number write with its command and
+  // latency.
+  Trigger<std::string, uint32_t> *get_write_success_trigger() { return &this->write_success_trigger_; }
+  Trigger<std::string, uint32_t> *get_write_failed_trigger() { return &this->write_failed_trigger_; }
+
+  // Subscription broker.  Each ``owner`` (``entity:<key>`` for YAML entities,
+  // ``action:<name>`` for automation actions, a plain name for C++ consumers)
+  // asks for ``target`` (for example ``"+EMETERPOWER"``) to be pushed every
+  // ``period_ms``; a period of ``0`` withdraws the request.  The EVSE receives
+  // the shortest period requested for every target, only changed targets are
+  // sent, and the whole table is restored after the EVSE reboots.
+  bool request_subscription(const std::string &target, const std::string &owner, uint32_t period_ms);
+  // Drop every request and clear all subscriptions on the EVSE.  The
+  // ``+EMETERCURRENT`` stream load management depends on is kept.
+  bool release_all_subscriptions();
+
+  // Raw ``AT+SUB``/``AT+UNSUB`` wrappers.  They bypass the broker, so the EVSE
+  // may drift from the requested table until the next EVSE reboot.
+  bool at_sub(const std::string &command, uint32_t period_ms);
+  bool at_unsub(const std::string &command = "");
+  bool send_reset_command();
+  bool send_authorize_command();
+  bool send_start_ap_command();
+
+  // Receives the ``+`` lines answering a raw command once its ``OK``/``ERROR``
+  // arrived.  The views are only valid during the call.
+  using QueryCallback = std::function<void(bool success, const std::vector<std::string_view> &lines)>;
+  // Send any AT command through the regular queue, for firmware features the
+  // component does not cover.  Captured are the lines that start with the
+  // command's own key, eg. ``+MODBUS`` for ``AT+MODBUS?``, and only the first
+  // of them for a query; known keys still update their entities.
+  // ``callback`` runs exactly once, also when ``false`` is returned.
+  bool query(const char *command, QueryCallback callback = nullptr);
+
+ protected:
+  void perform_update_(bool force);
+  static constexpr uint32_t ERROR_FLAG_PILOT_FAULT = 1u << 0;
+  static constexpr uint32_t ERROR_FLAG_DIODE_SHORT = 1u << 1;
+  static constexpr uint32_t ERROR_FLAG_LOCK_FAULT = 1u << 2;
+  static constexpr uint32_t ERROR_FLAG_UNLOCK_FAULT = 1u << 3;
+  static constexpr uint32_t ERROR_FLAG_RCM_TRIGGERED = 1u << 4;
+  static constexpr uint32_t ERROR_FLAG_RCM_SELF_TEST_FAULT = 1u << 5;
+  static constexpr uint32_t ERROR_FLAG_TEMPERATURE_HIGH = 1u << 6;
+  static constexpr uint32_t ERROR_FLAG_TEMPERATURE_FAULT = 1u << 7;
 
   // Record the current ``millis()`` timestamp for the supplied freshness slot
   // and consult that table when deciding whether a poll can be skipped.
   void mark_response_received_(FreshnessSlot slot);
   bool should_skip_poll_(FreshnessSlot slot) const;
+  uint32_t get_poll_interval_(FreshnessSlot slot) const;
 
   // Commands are queued while we wait for acknowledgements from the EVSE; this
   // struct tracks their progress and callbacks.
@@ -340,6 +573,9 @@ class ESP32EVSEComponent : public uart::UARTDevice, public PollingComponent {
     void append_unsigned(uint32_t value);
     const char *c_str() const { return this->buffer_; }
     size_t size() const { return this->length_; }
+    bool equals(const CommandString &other) const;
+    // Read requests end in ``?`` (for example ``AT+STATE?``).
+    bool is_query() const { return this->length_ > 0 && this->buffer_[this->length_ - 1] == '?'; }
 
    private:
     char buffer_[MAX_LENGTH + 1] = {0};
@@ -354,10 +590,23 @@ class ESP32EVSEComponent : public uart::UARTDevice, public PollingComponent {
       REQUEST_AUTHORIZATION_WRITE,
       EMETER_THREE_PHASE_WRITE,
       NUMBER_WRITE,
+      SUBSCRIPTION,
+      // Sentinel query sent after a timeout and while the link is down.  It
+      // completes only with the reply that follows its own ``+`` line, so late
+      // replies to abandoned commands are dropped instead of being matched to
+      // the next command.
+      PROBE,
+      // Raw command from ``query``; its ``+`` lines are captured.
+      RAW,
     };
 
     Type type{Type::GENERIC};
+    // Set by ``send_command_`` for generic commands and derived from ``type``
+    // for the others.
+    CommandPriority priority{CommandPriority::BACKGROUND};
     CommandString command;
+    // When the command entered the queue and when it was written to the UART.
+    uint32_t queued_time{0};
     uint32_t start_time{0};
     bool sent{false};
     // Switch writes store the requested state so callbacks can publish it once
@@ -367,200 +616,541 @@ class ESP32EVSEComponent : public uart::UARTDevice, public PollingComponent {
     // firmware expects, which lets us re-publish the same figure on success or
     // trigger a fresh read on failure.
     ESP32EVSEChargingCurrentNumber *number{nullptr};
-    float scaled_value{std::numeric_limits<float>::quiet_NaN()};
+    int32_t scaled_value{0};
+    // Subscription changes remember their target so a failed ``AT+SUB`` can be
+    // retried on the next sync.
+    uint8_t subscription_target{SUBSCRIPTION_TARGET_ALL};
+    // Key of this command's entries in ``command_callbacks_``; ``0`` if none.
+    uint16_t callback_id{0};
   };
 
-  void process_line_(const std::string &line);
+  // Completion callback waiting for the command tagged with ``id``; raw
+  // commands use ``query_callback`` instead.  Callbacks live outside
+  // ``PendingCommand`` to keep the queue slots small.
+  struct PendingCallback {
+    uint16_t id;
+    WriteCallback callback;
+    QueryCallback query_callback;
+  };
+
+  // Publish filter settings and the last value that passed it.
+  struct PublishFilter {
+    float delta{0.0f};
+    bool relative{false};
+    bool only_on_change{false};
+    bool has_last{false};
+    uint32_t min_interval_ms{0};
+    float last_value{0.0f};
+    uint32_t last_publish_ms{0};
+  };
+
+  // Registry entry of a configured entity.  The filter is created with the
+  // entry, so publishing never searches or allocates.
+  struct RegisteredEntity {
+    EntityBase *entity;
+    PublishFilter filter;
+  };
+
+  // One entity or action asking for a subscription target.
+  struct SubscriptionRequest {
+    uint8_t target;
+    std::string owner;
+    uint32_t period_ms;
+  };
+
+  // Number of response keys that can be subscribed to; checked against the
+  // parser's key table in the .cpp.
+  static constexpr size_t SUBSCRIPTION_TARGET_COUNT = 37;
+  static constexpr uint8_t SUBSCRIPTION_TARGET_ALL = 0xFF;
+  // ``subscriptions_applied_`` entry whose EVSE side state is not known.
+  static constexpr uint32_t SUBSCRIPTION_UNKNOWN = std::numeric_limits<uint32_t>::max();
+
+  // Longest EVSE response line we buffer; anything longer is discarded.
+  static constexpr size_t MAX_LINE_LENGTH = 512;
+
+  void consume_rx_chunk_(char *data, size_t length);
+  void append_partial_line_(const char *data, size_t length);
+  void handle_line_(std::string_view line);
+  // ``line`` is always NUL-terminated one past its end so handlers can hand
+  // value pointers to C parsing routines.
+  void process_line_(std::string_view line);
   void handle_ack_(bool success, bool timed_out);
+  // Keep ``line`` if it answers the raw command waiting for its ``OK``.
+  bool capture_raw_line_(std::string_view line);
+  void complete_command_(const PendingCommand &pending, bool success);
+  // Put the resync probe ahead of every unsent command.
+  void queue_probe_();
+  // Keep a timed out or abandoned probe query from being used as the probe.
+  void note_abandoned_(const PendingCommand &pending);
+  void record_round_trip_(uint32_t rtt_ms);
+  static CommandClass classify_command_(const PendingCommand &pending);
+  static CommandPriority command_priority_(const PendingCommand &pending);
+
+  // Boot stages in the order they are queued.  The next stage is queued once
+  // the command queue has drained.
+  enum class BootStage : uint8_t { CONTROL = 0, TELEMETRY, SETTINGS, IDENTITY, DONE };
+  // How ``process_line_`` handles the reply to a slot's query.  A plain slot
+  // carries one value that goes straight to one entity and is published from
+  // the table.  ``CUSTOM`` slots do more than publish (load management,
+  // telemetry, fingerprints, replies with several fields) and keep their
+  // ``update_*_`` handler.
+  enum class SlotFormat : uint8_t { CUSTOM = 0, INTEGER, FIXED, FLAG, TEXT };
+  // Query, startup stage, built-in poll interval and reply handling of one
+  // freshness slot.  ``SLOT_QUERIES`` is indexed by slot and lives in flash.
+  // ``entity`` is the one entity the reply feeds, ``NONE`` if it feeds several;
+  // numbers are scaled by the multiplier their platform sets.
+  struct SlotQuery {
+    FreshnessSlot slot;
+    const char *command;
+    BootStage stage;
+    uint32_t poll_interval_ms;
+    SlotFormat format;
+    EntityId entity;
+  };
+  static const SlotQuery SLOT_QUERIES[static_cast<size_t>(FreshnessSlot::SLOT_COUNT)];
+  static constexpr uint64_t slot_bit_(FreshnessSlot slot) { return uint64_t{1} << static_cast<size_t>(slot); }
+  bool is_slot_polled_(FreshnessSlot slot) const { return (this->polled_slots_ & slot_bit_(slot)) != 0; }
+  bool send_slot_query_(const SlotQuery &query);
+  // Publish the parsed reply of a plain slot to the slot's entity.
+  void publish_slot_value_(const SlotQuery &query, int64_t raw_value);
+  void publish_slot_text_(const SlotQuery &query, std::string_view text);
+  void queue_boot_stage_(BootStage stage);
+  void advance_boot_stage_();
+  void check_state_ready_();
+  // Turn ``stale_data`` off once the state is ready and, with ``warm_start``,
+  // every restored value has been confirmed.
+  void update_stale_data_();
+  void publish_command_stats_();
+  void report_malformed_lines_();
+  void log_command_stats_();
+  void set_link_state_(LinkState state);
+  void fail_pending_commands_();
   void process_next_command_();
   void update_state_(uint8_t state);
-  void update_enable_(bool enable);
   void update_temperature_(int count, int32_t high, int32_t low);
   void update_charging_current_(uint16_t value_tenths);
   void update_emeter_power_(uint32_t power_w);
-  void update_emeter_session_time_(uint32_t time_s);
-  void update_emeter_charging_time_(uint32_t time_s);
-  void update_uptime_(uint32_t seconds);
-  void update_chip_(const std::string &chip);
-  void update_version_(const std::string &version);
-  void update_idf_version_(const std::string &idf_version);
-  void update_build_time_(const std::string &build_time);
+  void update_chip_(std::string_view chip);
+  void update_version_(std::string_view version);
+  void update_build_time_(std::string_view build_time);
   void update_device_time_(uint32_t timestamp);
-  void update_wifi_sta_cfg_(const std::string &ssid);
-  void update_wifi_sta_ip_(const std::string &ip);
-  void update_wifi_sta_mac_(const std::string &mac);
-  void update_device_name_(const std::string &name);
-  void update_available_(bool available);
-  void update_request_authorization_(bool request);
-  void update_emeter_three_phase_(bool enabled);
+  void update_wifi_sta_cfg_(std::string_view ssid);
   void update_heap_(std::optional<uint32_t> heap_used_bytes,
                     std::optional<uint32_t> heap_total_bytes);
-  void update_energy_consumption_(float value);
-  void update_total_energy_consumption_(float value);
-  void update_voltages_(float l1, float l2, float l3);
-  void update_currents_(float l1, float l2, float l3);
+  void update_energy_consumption_(int64_t value_wh);
+  void integrate_power_(uint32_t power_w);
+  void anchor_session_energy_(int64_t value_wh);
+  void update_total_energy_consumption_(int64_t value_wh);
+  void update_voltages_(int64_t l1_mv, int64_t l2_mv, int64_t l3_mv);
+  void update_currents_(int64_t l1_ma, int64_t l2_ma, int64_t l3_ma);
   void update_wifi_status_(bool connected, int rssi);
-  void update_default_charging_current_(uint16_t value_tenths);
   void update_maximum_charging_current_(uint16_t value_amps);
-  void update_consumption_limit_(float value);
-  void update_default_consumption_limit_(float value);
-  void update_charging_time_limit_(uint32_t value);
-  void update_default_charging_time_limit_(uint32_t value);
-  void update_under_power_limit_(float value);
-  void update_default_under_power_limit_(float value);
-  void update_pending_authorization_(bool pending);
-  void update_charging_limit_reached_(bool reached);
   void update_error_flags_(uint32_t mask);
 
-  bool send_command_(const char *command);
-  bool send_command_(const CommandString &command);
-  void queue_pending_command_(const PendingCommand &pending);
-  bool is_front_sent_write_(PendingCommand::Type type,
-                            ESP32EVSEChargingCurrentNumber *number = nullptr) const;
+  bool send_command_(const char *command, CommandPriority priority);
+  bool send_command_(const CommandString &command, CommandPriority priority);
+  bool queue_pending_command_(const PendingCommand &pending);
+  // Class ``pending`` is scheduled in; aged commands count as ``SAFETY``.
+  static CommandPriority effective_priority_(const PendingCommand &pending, uint32_t now);
+  bool coalesce_pending_command_(const PendingCommand &pending);
+  // Queue a write or raw command and attach ``callback`` to it.
+  bool queue_with_callback_(PendingCommand &pending, WriteCallback &&callback,
+                            QueryCallback &&query_callback = nullptr);
+  // Fire the write triggers and run the callbacks of a finished command.
+  void finish_command_(const PendingCommand &pending, bool success, uint32_t latency_ms,
+                       const std::vector<std::string_view> &lines = {});
+  // Optimistic entities, see ``ESP32EVSEOptimisticEntity``.  Publish a queued
+  // write as provisional if its entity is optimistic.
+  void show_provisional_(const PendingCommand &pending);
+  // Record ``value`` as reported by the EVSE; returns ``false`` while the
+  // entity shows a provisional value, which must not be overwritten.
+  bool confirm_value_(ESP32EVSEOptimisticEntity *entity, float value);
+  // Settle a finished write of ``value``; returns ``false`` while a newer write
+  // to the same entity is still provisional.
+  bool settle_write_(ESP32EVSEOptimisticEntity *entity, const PendingCommand &pending, bool success, float value);
+  bool is_write_queued_(PendingCommand::Type type, ESP32EVSEChargingCurrentNumber *number = nullptr) const;
+  // Publish the confirmed value again after a failed optimistic switch write;
+  // returns ``false`` if there is nothing to roll back to.
+  bool roll_back_switch_(EntityId id);
+  // The switch each switch write command sets and the slot that reads it back.
+  struct SwitchWrite {
+    PendingCommand::Type type;
+    EntityId entity;
+    FreshnessSlot slot;
+  };
+  static const SwitchWrite SWITCH_WRITES[4];
+  // Entry of ``SWITCH_WRITES`` for ``type``, ``nullptr`` for other commands.
+  static const SwitchWrite *switch_write_(PendingCommand::Type type);
+  // Optimistic state of a configured switch, ``nullptr`` if it is not.
+  ESP32EVSEOptimisticEntity *switch_state_(EntityId id) const;
+  ESP32EVSEChargingCurrentNumber *number_entity_(EntityId id) const;
+  float scaled_number_value_(const ESP32EVSEChargingCurrentNumber *number, int64_t raw_value) const;
+  bool is_write_in_flight_(PendingCommand::Type type,
+                           ESP32EVSEChargingCurrentNumber *number = nullptr) const;
   void request_number_update_(ESP32EVSEChargingCurrentNumber *number);
-  void publish_scaled_number_(ESP32EVSEChargingCurrentNumber *number, float raw_value);
-  void publish_text_sensor_state_(text_sensor::TextSensor *sensor, const std::string &state);
+  void publish_scaled_number_(ESP32EVSEChargingCurrentNumber *number, int64_t raw_value, bool force = false);
+  // Publish to a registered entity; entities that are not configured are
+  // skipped.
+  void publish_sensor_(EntityId id, float value);
+  void publish_binary_sensor_(EntityId id, bool value);
+  void publish_switch_(EntityId id, bool value, bool force = false);
+  bool should_publish_(EntityId id, float value, bool force);
+  // ``EntityId`` a number is registered under, ``NONE`` if it is not.
+  EntityId number_id_(const ESP32EVSEChargingCurrentNumber *number) const;
+  void publish_text_sensor_state_(EntityId id, std::string_view state);
   bool is_valid_subscription_argument_(const std::string &argument) const;
-  bool has_error_binary_sensors_() const;
-
+  void sync_subscriptions_();
+  uint32_t desired_subscription_period_(uint8_t target) const;
+  bool queue_subscription_command_(uint8_t target, uint32_t period_ms);
+
+  // Commands live in a fixed pool of slots and the queue order is kept as a
+  // ring of one-byte slot indices.  Popping the front is O(1) and a priority
+  // insert only shifts indices (towards whichever end is closer) instead of
+  // copying ~100 byte ``PendingCommand`` records around.
   class PendingCommandQueue {
    public:
+    static constexpr size_t CAPACITY = ESP32EVSE_COMMAND_QUEUE_SIZE;
+
+    PendingCommandQueue();
     bool empty() const { return this->size_ == 0; }
+    bool full() const { return this->size_ >= CAPACITY; }
     size_t size() const { return this->size_; }
-    PendingCommand &front() { return this->commands_[0]; }
-    const PendingCommand &front() const { return this->commands_[0]; }
-    PendingCommand &operator[](size_t index) { return this->commands_[index]; }
-    const PendingCommand &operator[](size_t index) const { return this->commands_[index]; }
+    PendingCommand &front() { return (*this)[0]; }
+    const PendingCommand &front() const { return (*this)[0]; }
+    PendingCommand &operator[](size_t index) { return this->slots_[this->order_[this->position_(index)]]; }
+    const PendingCommand &operator[](size_t index) const {
+      return this->slots_[this->order_[this->position_(index)]];
+    }
     bool push_back(const PendingCommand &command);
     bool insert(size_t index, const PendingCommand &command);
     void pop_front();
 
    private:
-    // ``setup()`` and ``perform_update_`` enqueue more than thirty back-to-back
-    // requests before the UART loop processes acknowledgements.  Reserve enough
-    // static slots to hold that burst plus headroom for user actions so we keep
-    // everything queued instead of dropping commands.
-    static constexpr size_t MAX_PENDING_COMMANDS = 48;
-    std::array<PendingCommand, MAX_PENDING_COMMANDS> commands_{};
+    static_assert(CAPACITY > 0 && CAPACITY <= 255, "Command queue size must fit the one-byte slot index");
+
+    size_t position_(size_t index) const {
+      size_t position = this->head_ + index;
+      return position >= CAPACITY ? position - CAPACITY : position;
+    }
+
+    std::array<PendingCommand, CAPACITY> slots_{};
+    // Ring of slot indices in queue order, starting at ``head_``.
+    std::array<uint8_t, CAPACITY> order_{};
+    // Stack of unused slot indices; the top ``CAPACITY - size_`` entries are free.
+    std::array<uint8_t, CAPACITY> free_slots_{};
+    size_t head_{0};
     size_t size_{0};
   };
 
-  // Entity pointers registered via the setter functions above.  We guard every
-  // usage with a nullptr check so optional sensors don't consume memory when
-  // omitted from the configuration.
-  text_sensor::TextSensor *state_text_sensor_{nullptr};
-  text_sensor::TextSensor *chip_text_sensor_{nullptr};
-  text_sensor::TextSensor *version_text_sensor_{nullptr};
-  text_sensor::TextSensor *idf_version_text_sensor_{nullptr};
-  text_sensor::TextSensor *build_time_text_sensor_{nullptr};
-  text_sensor::TextSensor *device_time_text_sensor_{nullptr};
-  text_sensor::TextSensor *wifi_sta_ssid_text_sensor_{nullptr};
-  text_sensor::TextSensor *wifi_sta_ip_text_sensor_{nullptr};
-  text_sensor::TextSensor *wifi_sta_mac_text_sensor_{nullptr};
-  text_sensor::TextSensor *device_name_text_sensor_{nullptr};
-
-  ESP32EVSEEnableSwitch *enable_switch_{nullptr};
-  ESP32EVSEAvailableSwitch *available_switch_{nullptr};
-  ESP32EVSERequestAuthorizationSwitch *request_authorization_switch_{nullptr};
-  ESP32EVSEEmeterThreePhaseSwitch *emeter_three_phase_switch_{nullptr};
-
-  sensor::Sensor *temperature_high_sensor_{nullptr};
-  sensor::Sensor *temperature_low_sensor_{nullptr};
-  sensor::Sensor *heap_used_sensor_{nullptr};
-  sensor::Sensor *heap_total_sensor_{nullptr};
-  sensor::Sensor *energy_consumption_sensor_{nullptr};
-  sensor::Sensor *total_energy_consumption_sensor_{nullptr};
-  sensor::Sensor *voltage_l1_sensor_{nullptr};
-  sensor::Sensor *voltage_l2_sensor_{nullptr};
-  sensor::Sensor *voltage_l3_sensor_{nullptr};
-  sensor::Sensor *current_l1_sensor_{nullptr};
-  sensor::Sensor *current_l2_sensor_{nullptr};
-  sensor::Sensor *current_l3_sensor_{nullptr};
-  sensor::Sensor *wifi_rssi_sensor_{nullptr};
-
-  ESP32EVSEChargingCurrentNumber *charging_current_number_{nullptr};
-  ESP32EVSEChargingCurrentNumber *default_charging_current_number_{nullptr};
-  ESP32EVSEChargingCurrentNumber *maximum_charging_current_number_{nullptr};
+  // Entity registry.  ``entities_`` holds the configured entities in the order
+  // they were registered and ``entity_index_`` the position of each
+  // ``EntityId`` in it, ``NO_ENTITY`` if that entity is not configured.
+  static constexpr uint8_t NO_ENTITY = 0xFF;
+  static_assert(static_cast<size_t>(EntityId::ENTITY_COUNT) < NO_ENTITY, "entity ids must fit the one-byte index");
+  template<typename T> T *entity_(EntityId id) const {
+    const uint8_t index = this->entity_index_[static_cast<size_t>(id)];
+    return index == NO_ENTITY ? nullptr : static_cast<T *>(this->entities_[index].entity);
+  }
+  bool has_entity_(EntityId id) const { return this->entity_index_[static_cast<size_t>(id)] != NO_ENTITY; }
+  std::vector<RegisteredEntity> entities_;
+  std::array<uint8_t, static_cast<size_t>(EntityId::ENTITY_COUNT)> entity_index_;
+
+  // Power integration state: the previous sample, the last ``+EMETERCONSUM``
+  // (``-1`` until one arrives) and the energy integrated since, in mJ (W·ms).
+  uint32_t last_power_w_{0};
+  uint32_t last_power_ms_{0};
+  bool has_last_power_{false};
+  int64_t session_energy_anchor_wh_{-1};
+  uint64_t session_energy_since_anchor_mj_{0};
+  float session_energy_published_wh_{0.0f};
+  // ``+MAXCHCUR`` in the number's units; caps charging current writes.
   float maximum_charging_current_limit_{std::numeric_limits<float>::quiet_NaN()};
-  ESP32EVSEChargingCurrentNumber *consumption_limit_number_{nullptr};
-  ESP32EVSEChargingCurrentNumber *default_consumption_limit_number_{nullptr};
-  ESP32EVSEChargingCurrentNumber *charging_time_limit_number_{nullptr};
-  ESP32EVSEChargingCurrentNumber *default_charging_time_limit_number_{nullptr};
-  ESP32EVSEChargingCurrentNumber *under_power_limit_number_{nullptr};
-  ESP32EVSEChargingCurrentNumber *default_under_power_limit_number_{nullptr};
-
-  sensor::Sensor *emeter_power_sensor_{nullptr};
-  sensor::Sensor *emeter_session_time_sensor_{nullptr};
-  sensor::Sensor *emeter_charging_time_sensor_{nullptr};
-  sensor::Sensor *uptime_sensor_{nullptr};
-
-  ESP32EVSEResetButton *reset_button_{nullptr};
-  ESP32EVSEAuthorizeButton *authorize_button_{nullptr};
-  ESP32EVSEStartAccessPointButton *start_ap_button_{nullptr};
-
-  ESP32EVSEPendingAuthorizationBinarySensor *pending_authorization_binary_sensor_{nullptr};
-  ESP32EVSEWifiConnectedBinarySensor *wifi_connected_binary_sensor_{nullptr};
-  ESP32EVSEChargingLimitReachedBinarySensor *charging_limit_reached_binary_sensor_{nullptr};
-  ESP32EVSEPilotFaultBinarySensor *pilot_fault_binary_sensor_{nullptr};
-  ESP32EVSEDiodeShortBinarySensor *diode_short_binary_sensor_{nullptr};
-  ESP32EVSELockFaultBinarySensor *lock_fault_binary_sensor_{nullptr};
-  ESP32EVSEUnlockFaultBinarySensor *unlock_fault_binary_sensor_{nullptr};
-  ESP32EVSERCMTriggeredBinarySensor *rcm_triggered_binary_sensor_{nullptr};
-  ESP32EVSERCMSelfTestFaultBinarySensor *rcm_self_test_fault_binary_sensor_{nullptr};
-  ESP32EVSETemperatureHighFaultBinarySensor *temperature_high_fault_binary_sensor_{nullptr};
-  ESP32EVSETemperatureFaultBinarySensor *temperature_fault_binary_sensor_{nullptr};
-  ESP32EVSETimeoutFaultBinarySensor *timeout_fault_binary_sensor_{nullptr};
-
-  // UART receive buffer and queue of in-flight commands awaiting responses.
-  std::string read_buffer_;
+
+  // UART line assembly buffer (one spare byte for the terminator) and queue of
+  // in-flight commands awaiting responses.
+  std::array<char, MAX_LINE_LENGTH + 1> read_buffer_{};
+  size_t read_length_{0};
   PendingCommandQueue pending_commands_;
+  uint32_t dropped_commands_{0};
+  uint32_t merged_commands_{0};
+  std::vector<PendingCallback> command_callbacks_;
+  // Lines captured for the raw command at the head of the queue, separated by
+  // ``\n``.
+  std::string raw_response_;
+  uint16_t last_callback_id_{0};
+  Trigger<std::string, uint32_t> write_success_trigger_{};
+  Trigger<std::string, uint32_t> write_failed_trigger_{};
+  uint32_t suppressed_publishes_{0};
+  uint8_t command_window_{1};
+  // A response key with malformed lines is warned about once per update
+  // interval; further lines are only counted and summarised in ``update()``.
+  uint64_t malformed_keys_warned_{0};
+  uint32_t malformed_lines_unreported_{0};
 
   // Per-slot timestamps that power the freshness tracker.  A ``0`` entry means
   // the slot has never received a response and should not suppress polling yet.
   std::array<uint32_t, static_cast<size_t>(FreshnessSlot::SLOT_COUNT)> last_response_millis_{};
+  // YAML overrides of the per-slot poll interval; a slot only uses its entry
+  // when the matching bit in ``poll_interval_overrides_`` is set.
+  std::array<uint32_t, static_cast<size_t>(FreshnessSlot::SLOT_COUNT)> poll_intervals_{};
+  uint64_t poll_interval_overrides_{0};
+  // Slots queried during startup and on every update, one bit per slot.  The
+  // charger state, enable flag and authorization request are always polled.
+  uint64_t polled_slots_{slot_bit_(FreshnessSlot::STATE) | slot_bit_(FreshnessSlot::ENABLE) |
+                         slot_bit_(FreshnessSlot::PENDING_AUTHORIZATION)};
+  MeterReadings meter_readings_;
+
+  // Subscription broker state: what was requested and what the EVSE was last
+  // told per target (``0`` = not subscribed).  Syncing starts with the initial
+  // refresh in ``setup()``.
+  std::vector<SubscriptionRequest> subscription_requests_;
+  std::array<uint32_t, SUBSCRIPTION_TARGET_COUNT> subscriptions_applied_{};
+  bool subscriptions_dirty_{false};
+  bool subscriptions_started_{false};
+
+  // Link health.  The command timeout is ``k`` times the p99 of the last
+  // ``RTT_SAMPLES`` round trips; ``rtt_samples_`` is a ring of those samples.
+  static constexpr size_t RTT_SAMPLES = 32;
+  std::array<uint16_t, RTT_SAMPLES> rtt_samples_{};
+  uint8_t rtt_sample_count_{0};
+  uint8_t rtt_sample_next_{0};
+  uint32_t command_timeout_ms_{5000};
+  LinkState link_state_{LinkState::UP};
+  uint8_t consecutive_timeouts_{0};
+  uint32_t probe_backoff_ms_{0};
+  uint32_t last_probe_ms_{0};
+  // Set by a timeout until a probe completes; meanwhile only the probe is sent.
+  // ``resync_line_seen_`` records its ``+`` line, after which the next reply
+  // is the probe's own.  ``abandoned_probes_`` has a bit per probe query
+  // abandoned since the resync started; those are not used as the probe.
+  bool resyncing_{false};
+  bool resync_line_seen_{false};
+  uint8_t abandoned_probes_{0};
+  // In-time acks still needed after a timeout before ``command_window_`` is
+  // used again; until then one command is sent at a time.
+  uint8_t serial_acks_remaining_{0};
+
+  // Command latency statistics, see ``LatencyHistogram``.
+  std::array<LatencyHistogram, COMMAND_CLASS_COUNT> round_trip_histograms_{};
+  LatencyHistogram queue_wait_histogram_{};
+  std::array<LatencyHistogram, COMMAND_PRIORITY_COUNT> priority_wait_histograms_{};
+  size_t queue_high_water_mark_{0};
 
   Trigger<> ready_trigger_{};
+
+  // Last ``+ERROR`` mask; only bits that differ from it are published.
+  uint32_t error_flags_{0};
+  bool has_error_flags_{false};
+  Trigger<uint8_t> fault_raised_trigger_{};
+  Trigger<uint8_t> fault_cleared_trigger_{};
+
+  BootStage boot_stage_{BootStage::CONTROL};
+  bool state_ready_{false};
+  uint32_t time_to_first_state_ms_{0};
+  Trigger<> state_ready_trigger_{};
+  bool stale_data_{true};
+
+#ifdef USE_ESP32EVSE_WARM_START
+  // Flash layout of the warm-start snapshot.  Fields are ordered so the struct
+  // has no padding and can be compared with ``memcmp``; strings are
+  // NUL-terminated and truncated to fit.
+  struct WarmStartSnapshot {
+    uint32_t magic;
+    float charging_current;
+    int64_t total_energy_wh;
+    uint16_t valid;  // WARM_START_* bits of the numeric fields
+    uint8_t enable;
+    char state[5];
+    char version[32];
+    char build_time[32];
+    char chip[32];
+    char idf_version[32];
+    char wifi_sta_mac[24];
+  };
+  static constexpr uint16_t WARM_START_ENABLE = 1u << 0;
+  static constexpr uint16_t WARM_START_CHARGING_CURRENT = 1u << 1;
+  static constexpr uint16_t WARM_START_TOTAL_ENERGY = 1u << 2;
+  // Whether the EVSE still runs the firmware the snapshot was taken from.
+  enum class Fingerprint : uint8_t { UNKNOWN = 0, PENDING, MATCHED, CHANGED };
+
+  void restore_warm_start_();
+  void save_warm_start_();
+  void check_fingerprint_(FreshnessSlot slot, std::string_view value);
+  // Snapshot string backing an identity slot, ``nullptr`` for other slots.
+  const char *cached_identity_(FreshnessSlot slot) const;
+  // True for static slots whose query waits for the fingerprint check.
+  bool defers_to_fingerprint_(FreshnessSlot slot) const;
+
+  ESPPreferenceObject warm_start_pref_;
+  WarmStartSnapshot warm_start_{};
+  std::string warm_start_key_;
+  uint32_t warm_start_save_interval_ms_{0};
+  uint32_t warm_start_saved_ms_{0};
+  bool warm_start_saved_{false};
+  Fingerprint fingerprint_{Fingerprint::UNKNOWN};
+  // Slots published from the snapshot that the EVSE has not answered yet.
+  uint64_t unconfirmed_slots_{0};
+  // Fingerprint slots that matched so far, one bit each for VER and BUILDTIME.
+  uint8_t fingerprint_matched_{0};
+  char firmware_version_[sizeof(WarmStartSnapshot::version)]{};
+  char firmware_build_time_[sizeof(WarmStartSnapshot::build_time)]{};
+#endif
+
+#ifdef USE_ESP32EVSE_PARSER_STATS
+ public:
+  // Opt-in instrumentation enabled with ``parser_stats: true``.  Each bucket
+  // counts the lines of one response key and the microseconds and CPU cycles
+  // spent parsing and publishing them, so per-prefix cost can be measured on
+  // the real device.  Cycles are the figure to compare between chips with and
+  // without an FPU, since they do not depend on the clock.
+  static constexpr size_t PARSER_STAT_SLOTS = 40;
+
+ protected:
+  struct ParserStats {
+    uint32_t window_start_ms{0};
+    uint32_t lines{0};
+    uint32_t total_us{0};
+    uint32_t max_us{0};
+    uint64_t total_cycles{0};
+    std::array<uint32_t, PARSER_STAT_SLOTS> slot_lines{};
+    std::array<uint32_t, PARSER_STAT_SLOTS> slot_us{};
+    std::array<uint64_t, PARSER_STAT_SLOTS> slot_cycles{};
+  };
+
+  void record_line_stats_(std::string_view line, uint32_t elapsed_us, uint32_t elapsed_cycles);
+  void log_parser_stats_();
+
+  ParserStats parser_stats_{};
+#endif
+
+#ifdef USE_ESP32EVSE_TELEMETRY
+  void record_telemetry_(TelemetryChannel channel, int64_t value);
+  void continue_telemetry_dump_();
+
+  // Progress of ``dump_telemetry``.  Samples up to ``now`` are logged per
+  // channel in timestamp order, resuming after ``last_timestamp``, so blocks
+  // recycled in the meantime do not shift the output.
+  struct TelemetryDump {
+    bool active{false};
+    uint16_t channel_mask{0};
+    uint8_t channel{0};
+    bool channel_started{false};
+    bool has_last{false};
+    uint32_t now{0};
+    uint32_t window_ms{0};
+    uint32_t last_timestamp{0};
+  };
+
+  TelemetryLog telemetry_{};
+  size_t telemetry_buffer_bytes_{0};
+  uint32_t telemetry_interval_ms_{0};
+  uint16_t telemetry_channels_{0};
+  TelemetryDump telemetry_dump_{};
+#endif
+
+#ifdef USE_ESP32EVSE_LOAD_MANAGEMENT
+  void handle_grid_sample_(uint8_t phase, float amps);
+  void run_load_management_(uint32_t now, bool on_sample);
+  // Whether ``+EMETERCURRENT`` arrived after the last current change.
+  bool own_current_settled_() const;
+  void write_load_management_current_(int32_t tenths, uint32_t now, uint32_t sample_ms);
+
+  std::array<sensor::Sensor *, 3> grid_current_sensors_{};
+  // Latest grid reading per phase in amps and when it arrived.
+  std::array<float, 3> grid_current_amps_{};
+  std::array<uint32_t, 3> grid_sample_ms_{};
+  int32_t fuse_limit_tenths_{0};
+  int32_t hysteresis_tenths_{10};
+  uint32_t min_change_interval_ms_{10000};
+  uint32_t grid_timeout_ms_{10000};
+  int32_t failsafe_current_tenths_{60};
+  LoadManagementState load_management_state_{LoadManagementState::WAITING};
+  // True while the fuse leaves less than the minimum charging current.
+  bool load_management_short_{false};
+  // ``charging_current`` as last written or reported, ``-1`` until known.
+  int32_t charging_current_tenths_{-1};
+  int32_t load_management_target_tenths_{0};
+  uint32_t last_current_change_ms_{0};
+  // A refused or failed write is retried after ``min_change_interval``.
+  bool load_management_write_failed_{false};
+  uint32_t load_management_failed_ms_{0};
+  // Grid sample time behind the write awaiting its ``OK``, ``0`` for none.
+  uint32_t load_management_write_sample_ms_{0};
+  uint32_t load_management_reaction_ms_{0};
+#endif
+};
+
+// Switches and numbers wait for the EVSE's acknowledgement before publishing a
+// write, unless they are optimistic: then the written value is published right
+// away and stays provisional until the EVSE acknowledges it.  A failed write
+// rolls back to the last value the EVSE confirmed.
+class ESP32EVSEOptimisticEntity {
+ public:
+  void set_optimistic(bool optimistic) { this->optimistic_ = optimistic; }
+  bool is_optimistic() const { return this->optimistic_; }
+  // True while the published state is a write the EVSE has not confirmed.
+  bool is_provisional() const { return this->provisional_; }
+  // Last value the EVSE reported or acknowledged (``1``/``0`` for switches),
+  // NAN until known.
+  float get_confirmed_value() const { return this->confirmed_value_; }
+
+ protected:
+  friend class ESP32EVSEComponent;
+
+  bool optimistic_{false};
+  bool provisional_{false};
+  float confirmed_value_{NAN};
 };
 
 // Lightweight wrappers for the ESPHome entity classes.  They forward state
 // changes initiated from external clients back to the component implementation.
-class ESP32EVSEEnableSwitch : public switch_::Switch, public Parented<ESP32EVSEComponent> {
+class ESP32EVSEEnableSwitch : public switch_::Switch,
+                              public ESP32EVSEOptimisticEntity,
+                              public Parented<ESP32EVSEComponent> {
  protected:
   void write_state(bool state) override;
 };
 
-class ESP32EVSEAvailableSwitch : public switch_::Switch, public Parented<ESP32EVSEComponent> {
+class ESP32EVSEAvailableSwitch : public switch_::Switch,
+                                 public ESP32EVSEOptimisticEntity,
+                                 public Parented<ESP32EVSEComponent> {
  protected:
   void write_state(bool state) override;
 };
 
 class ESP32EVSERequestAuthorizationSwitch
-    : public switch_::Switch, public Parented<ESP32EVSEComponent> {
+    : public switch_::Switch, public ESP32EVSEOptimisticEntity, public Parented<ESP32EVSEComponent> {
  protected:
   void write_state(bool state) override;
 };
 
 class ESP32EVSEEmeterThreePhaseSwitch
-    : public switch_::Switch, public Parented<ESP32EVSEComponent> {
+    : public switch_::Switch, public ESP32EVSEOptimisticEntity, public Parented<ESP32EVSEComponent> {
  protected:
   void write_state(bool state) override;
 };
 
 // Numbers represent adjustable EVSE parameters.  The multiplier bridges between
 // human-friendly units and the scaled integers required by the UART protocol.
-class ESP32EVSEChargingCurrentNumber : public number::Number, public Parented<ESP32EVSEComponent> {
+class ESP32EVSEChargingCurrentNumber : public number::Number,
+                                       public ESP32EVSEOptimisticEntity,
+                                       public Parented<ESP32EVSEComponent> {
  public:
   ESP32EVSEChargingCurrentNumber();
   void set_command(const std::string &command) { this->command_ = command; }
   void set_multiplier(float multiplier) { this->multiplier_ = multiplier; }
+  // Slot whose query reads the value back after a failed write.
+  void set_slot(ESP32EVSEComponent::FreshnessSlot slot) { this->slot_ = slot; }
   const std::string &get_command() const { return this->command_; }
   float get_multiplier() const { return this->multiplier_; }
+  ESP32EVSEComponent::FreshnessSlot get_slot() const { return this->slot_; }
 
  protected:
   void control(float value) override;
 
   std::string command_{"AT+CHCUR"};
   float multiplier_{10.0f};
+  ESP32EVSEComponent::FreshnessSlot slot_{ESP32EVSEComponent::FreshnessSlot::CHARGING_CURRENT};
 };
 
 // Buttons simply trigger their associated EVSE command when pressed.
@@ -626,27 +1216,30 @@ class ESP32EVSETimeoutFaultBinarySensor
     : public binary_sensor::BinarySensor,
       public Parented<ESP32EVSEComponent> {};
 
+class ESP32EVSEStaleDataBinarySensor
+    : public binary_sensor::BinarySensor,
+      public Parented<ESP32EVSEComponent> {};
+
 template<typename... Ts>
 class ESP32EVSEManagedSubscriptionAction : public Action<Ts...>, public Parented<ESP32EVSEComponent> {
  public:
   TEMPLATABLE_VALUE(uint32_t, period)
 
   void set_command(const std::string &command) { this->command_ = command; }
+  // Requests are ref-counted per owner; every ``<entity>.subscribe`` action
+  // name is one owner, so ``never`` only withdraws that action's request.
+  void set_owner(const std::string &owner) { this->owner_ = owner; }
 
   void play(const Ts &... x) override {
     auto *parent = this->parent_;
     if (parent == nullptr || this->command_.empty())
       return;
-    uint32_t period = this->period_.value(x...);
-    if (period == 0) {
-      parent->at_unsub(this->command_);
-    } else {
-      parent->at_sub(this->command_, period);
-    }
+    parent->request_subscription(this->command_, this->owner_, this->period_.value(x...));
   }
 
  protected:
   std::string command_;
+  std::string owner_;
 };
 
 template<typename... Ts>
@@ -655,7 +1248,7 @@ class ESP32EVSEUnsubscribeAllAction : public Action<Ts...>, public Parented<ESP3
   void play(const Ts &... x) override {
     if (this->parent_ == nullptr)
       return;
-    this->parent_->at_unsub();
+    this->parent_->release_all_subscriptions();
   }
 };
 
@@ -669,5 +1262,106 @@ class ESP32EVSEForceUpdateAction : public Action<Ts...>, public Parented<ESP32EV
   }
 };
 
+// Writes one switch or number and holds the automation until the EVSE has
+// acknowledged it.  The automation continues on failure too; use the
+// ``on_write_failed`` trigger to react to that.
+template<typename... Ts>
+class ESP32EVSEWriteAction : public Action<Ts...>, public Parented<ESP32EVSEComponent> {
+ public:
+  TEMPLATABLE_VALUE(bool, state)
+  TEMPLATABLE_VALUE(float, value)
+
+  void set_target(ESP32EVSEComponent::WriteTarget target) { this->target_ = target; }
+  // Number writes go to the number's own charger.
+  void set_number(ESP32EVSEChargingCurrentNumber *number) { this->number_ = number; }
+
+  void play_complex(const Ts &... x) override {
+    this->num_running_++;
+    auto next = std::bind(&ESP32EVSEWriteAction<Ts...>::play_next_, this, x...);
+    ESP32EVSEComponent::WriteCallback callback = [next](bool success, uint32_t latency_ms) { next(); };
+    auto *parent = this->target_ == ESP32EVSEComponent::WriteTarget::NUMBER && this->number_ != nullptr
+                       ? this->number_->get_parent()
+                       : this->parent_;
+    if (parent == nullptr) {
+      callback(false, 0);
+      return;
+    }
+    switch (this->target_) {
+      case ESP32EVSEComponent::WriteTarget::ENABLE:
+        parent->write_enable_state(this->state_.value(x...), std::move(callback));
+        break;
+      case ESP32EVSEComponent::WriteTarget::AVAILABLE:
+        parent->write_available_state(this->state_.value(x...), std::move(callback));
+        break;
+      case ESP32EVSEComponent::WriteTarget::REQUEST_AUTHORIZATION:
+        parent->write_request_authorization_state(this->state_.value(x...), std::move(callback));
+        break;
+      case ESP32EVSEComponent::WriteTarget::EMETER_THREE_PHASE:
+        parent->write_emeter_three_phase_state(this->state_.value(x...), std::move(callback));
+        break;
+      case ESP32EVSEComponent::WriteTarget::CHARGING_CURRENT:
+        parent->write_charging_current(this->value_.value(x...), std::move(callback));
+        break;
+      case ESP32EVSEComponent::WriteTarget::NUMBER:
+        parent->write_number_value(this->number_, this->value_.value(x...), std::move(callback));
+        break;
+    }
+  }
+
+  void play(const Ts &... x) override {}
+
+ protected:
+  ESP32EVSEComponent::WriteTarget target_{ESP32EVSEComponent::WriteTarget::ENABLE};
+  ESP32EVSEChargingCurrentNumber *number_{nullptr};
+};
+
+// Sends a raw AT command and holds the automation until it is answered.
+// ``on_response`` gets the outcome and the captured lines.
+template<typename... Ts>
+class ESP32EVSESendCommandAction : public Action<Ts...>, public Parented<ESP32EVSEComponent> {
+ public:
+  TEMPLATABLE_VALUE(std::string, command)
+
+  Trigger<bool, std::vector<std::string>> *get_response_trigger() { return &this->response_trigger_; }
+
+  void play_complex(const Ts &... x) override {
+    this->num_running_++;
+    auto next = std::bind(&ESP32EVSESendCommandAction<Ts...>::play_next_, this, x...);
+    if (this->parent_ == nullptr) {
+      next();
+      return;
+    }
+    const std::string command = this->command_.value(x...);
+    this->parent_->query(command.c_str(), [this, next](bool success, const std::vector<std::string_view> &lines) {
+      this->response_trigger_.trigger(success, std::vector<std::string>(lines.begin(), lines.end()));
+      next();
+    });
+  }
+
+  void play(const Ts &... x) override {}
+
+ protected:
+  Trigger<bool, std::vector<std::string>> response_trigger_{};
+};
+
+#ifdef USE_ESP32EVSE_TELEMETRY
+template<typename... Ts>
+class ESP32EVSETelemetryDumpAction : public Action<Ts...>, public Parented<ESP32EVSEComponent> {
+ public:
+  TEMPLATABLE_VALUE(uint32_t, window)
+
+  void set_channel_mask(uint16_t channel_mask) { this->channel_mask_ = channel_mask; }
+
+  void play(const Ts &... x) override {
+    if (this->parent_ == nullptr)
+      return;
+    this->parent_->dump_telemetry(this->window_.value(x...), this->channel_mask_);
+  }
+
+ protected:
+  uint16_t channel_mask_{0};
+};
+#endif
+
 }  // namespace esp32evse
 }  // namespace esphome
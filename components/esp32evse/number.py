@@ -25,15 +25,22 @@ try:
 except ImportError:  # pragma: no cover - compatibility with older ESPHome releases
     from esphome.const import UNIT_KILOWATT_HOURS as UNIT_KILOWATT_HOUR
 
-from . import CONF_ESP32EVSE_ID, ESP32EVSEComponent, esp32evse_ns
+from . import (
+    CONF_ESP32EVSE_ID,
+    PUBLISH_FILTER_SCHEMA,
+    OPTIMISTIC_SCHEMA,
+    QUERY_OPTIONS_SCHEMA,
+    ESP32EVSEChargingCurrentNumber,
+    ESP32EVSEComponent,
+    FreshnessSlot,
+    register_entity,
+    register_optimistic,
+    register_publish_filters,
+    register_query_options,
+)
 
 DEPENDENCIES = ["esp32evse"]
 
-# A single C++ class implements all the different numeric entities.  Behaviour
-# differences (command name, ranges, etc.) are controlled via metadata below.
-ESP32EVSEChargingCurrentNumber = esp32evse_ns.class_(
-    "ESP32EVSEChargingCurrentNumber", number.Number
-)
 
 CONF_CHARGING_CURRENT = "charging_current"
 CONF_DEFAULT_CHARGING_CURRENT = "default_charging_current"
@@ -85,7 +92,7 @@ def _build_number_schema(
             cv.Optional(CONF_STEP): cv.positive_float,
             cv.Optional(CONF_MULTIPLIER): cv.positive_float,
         }
-    )
+    ).extend(QUERY_OPTIONS_SCHEMA).extend(PUBLISH_FILTER_SCHEMA).extend(OPTIMISTIC_SCHEMA)
     defaults = {
         CONF_MIN_VALUE: default_min,
         CONF_MAX_VALUE: default_max,
@@ -95,16 +102,21 @@ def _build_number_schema(
     return schema, defaults
 
 
-def _make_number_type(*, command, setter, **kwargs):
+def _make_number_type(*, command, slot, **kwargs):
     """Bundle together the metadata required to expose an EVSE number entity."""
 
     schema, defaults = _build_number_schema(**kwargs)
-    return {"schema": schema, "defaults": defaults, "command": command, "setter": setter}
+    return {
+        "schema": schema,
+        "defaults": defaults,
+        "command": command,
+        "slot": slot,
+    }
 
 
 # Metadata describing how each YAML key maps to an EVSE command, including
-# presentation defaults and which setter on the C++ class should receive the
-# resulting entity.
+# presentation defaults and the freshness slot, whose name is also the
+# ``EntityId`` the resulting entity is registered under.
 _NUMBER_TYPES = {
     CONF_CHARGING_CURRENT: _make_number_type(
         icon="mdi:current-ac",
@@ -114,7 +126,7 @@ _NUMBER_TYPES = {
         default_step=0.1,
         default_multiplier=10.0,
         command="AT+CHCUR",
-        setter="set_charging_current_number",
+        slot="CHARGING_CURRENT",
     ),
     CONF_DEFAULT_CHARGING_CURRENT: _make_number_type(
         icon="mdi:current-ac",
@@ -125,7 +137,7 @@ _NUMBER_TYPES = {
         default_multiplier=10.0,
         entity_category=ENTITY_CATEGORY_CONFIG,
         command="AT+DEFCHCUR",
-        setter="set_default_charging_current_number",
+        slot="DEFAULT_CHARGING_CURRENT",
     ),
     CONF_MAXIMUM_CHARGING_CURRENT: _make_number_type(
         icon="mdi:current-ac",
@@ -136,7 +148,7 @@ _NUMBER_TYPES = {
         default_multiplier=1.0,
         entity_category=ENTITY_CATEGORY_CONFIG,
         command="AT+MAXCHCUR",
-        setter="set_maximum_charging_current_number",
+        slot="MAXIMUM_CHARGING_CURRENT",
     ),
     CONF_CONSUMPTION_LIMIT: _make_number_type(
         icon="mdi:gauge",
@@ -147,7 +159,7 @@ _NUMBER_TYPES = {
         default_multiplier=1000.0,
         device_class=DEVICE_CLASS_ENERGY,
         command="AT+CONSUMLIM",
-        setter="set_consumption_limit_number",
+        slot="CONSUMPTION_LIMIT",
     ),
     CONF_DEFAULT_CONSUMPTION_LIMIT: _make_number_type(
         icon="mdi:gauge",
@@ -159,7 +171,7 @@ _NUMBER_TYPES = {
         device_class=DEVICE_CLASS_ENERGY,
         entity_category=ENTITY_CATEGORY_CONFIG,
         command="AT+DEFCONSUMLIM",
-        setter="set_default_consumption_limit_number",
+        slot="DEFAULT_CONSUMPTION_LIMIT",
     ),
     CONF_CHARGING_TIME_LIMIT: _make_number_type(
         icon="mdi:timer-outline",
@@ -169,7 +181,7 @@ _NUMBER_TYPES = {
         default_step=0.5,
         default_multiplier=3600.0,
         command="AT+CHTIMELIM",
-        setter="set_charging_time_limit_number",
+        slot="CHARGING_TIME_LIMIT",
     ),
     CONF_DEFAULT_CHARGING_TIME_LIMIT: _make_number_type(
         icon="mdi:timer-outline",
@@ -180,7 +192,7 @@ _NUMBER_TYPES = {
         default_multiplier=3600.0,
         entity_category=ENTITY_CATEGORY_CONFIG,
         command="AT+DEFCHTIMELIM",
-        setter="set_default_charging_time_limit_number",
+        slot="DEFAULT_CHARGING_TIME_LIMIT",
     ),
     CONF_UNDER_POWER_LIMIT: _make_number_type(
         icon="mdi:flash-outline",
@@ -191,7 +203,7 @@ _NUMBER_TYPES = {
         default_multiplier=1000.0,
         device_class=DEVICE_CLASS_POWER,
         command="AT+UNDERPOWERLIM",
-        setter="set_under_power_limit_number",
+        slot="UNDER_POWER_LIMIT",
     ),
     CONF_DEFAULT_UNDER_POWER_LIMIT: _make_number_type(
         icon="mdi:flash-outline",
@@ -203,7 +215,7 @@ _NUMBER_TYPES = {
         device_class=DEVICE_CLASS_POWER,
         entity_category=ENTITY_CATEGORY_CONFIG,
         command="AT+DEFUNDERPOWERLIM",
-        setter="set_default_under_power_limit_number",
+        slot="DEFAULT_UNDER_POWER_LIMIT",
     ),
 }
 
@@ -227,6 +239,15 @@ async def to_code(config):
     """Create each configured number entity and associate it with the EVSE."""
 
     parent = await cg.get_variable(config[CONF_ESP32EVSE_ID])
+    # ``AT+CHCUR`` is refreshed by the ``+CHCUR`` query and subscription target.
+    register_query_options(
+        parent,
+        config,
+        {
+            key: (meta["slot"], f'"+{meta["command"][len("AT+"):]}"')
+            for key, meta in _NUMBER_TYPES.items()
+        },
+    )
     for key, meta in _NUMBER_TYPES.items():
         if (number_config := config.get(key)) is None:
             continue
@@ -245,9 +266,13 @@ async def to_code(config):
         await cg.register_parented(num, config[CONF_ESP32EVSE_ID])
         # Remember which AT command updates the EVSE when this entity changes.
         cg.add(num.set_command(meta["command"]))
+        # Read the value back through this slot when a write fails.
+        cg.add(num.set_slot(getattr(FreshnessSlot, meta["slot"])))
         multiplier = number_config.get(CONF_MULTIPLIER, defaults[CONF_MULTIPLIER])
         # Some EVSE commands expect scaled integers (for example tenths of an
         # ampere).  The multiplier keeps the ESPHome API user friendly while
         # still speaking the correct serial protocol.
         cg.add(num.set_multiplier(multiplier))
-        cg.add(getattr(parent, meta["setter"])(num))
+        register_entity(parent, meta["slot"], num)
+    await register_publish_filters(parent, config, _NUMBER_TYPES)
+    await register_optimistic(config, _NUMBER_TYPES)
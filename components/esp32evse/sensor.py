@@ -23,6 +23,7 @@ from esphome.const import (
     UNIT_AMPERE,
     UNIT_CELSIUS,
     UNIT_DECIBEL_MILLIWATT,
+    UNIT_MILLISECOND,
     UNIT_SECOND,
     UNIT_VOLT,
 )
@@ -32,7 +33,15 @@ try:
 except ImportError:
     from esphome.const import UNIT_WATT_HOURS as UNIT_WATT_HOUR
 
-from . import CONF_ESP32EVSE_ID, ESP32EVSEComponent
+from . import (
+    CONF_ESP32EVSE_ID,
+    PUBLISH_FILTER_SCHEMA,
+    QUERY_OPTIONS_SCHEMA,
+    ESP32EVSEComponent,
+    register_entity,
+    register_publish_filters,
+    register_query_options,
+)
 
 DEPENDENCIES = ["esp32evse"]
 
@@ -47,6 +56,7 @@ CONF_HEAP_USED = "heap_used"
 CONF_HEAP_TOTAL = "heap_total"
 CONF_ENERGY_CONSUMPTION = "energy_consumption"
 CONF_TOTAL_ENERGY_CONSUMPTION = "total_energy_consumption"
+CONF_SESSION_ENERGY = "session_energy"
 CONF_VOLTAGE_L1 = "voltage_l1"
 CONF_VOLTAGE_L2 = "voltage_l2"
 CONF_VOLTAGE_L3 = "voltage_l3"
@@ -54,6 +64,89 @@ CONF_CURRENT_L1 = "current_l1"
 CONF_CURRENT_L2 = "current_l2"
 CONF_CURRENT_L3 = "current_l3"
 CONF_WIFI_RSSI = "wifi_rssi"
+CONF_QUERY_LATENCY = "query_latency"
+CONF_WRITE_LATENCY = "write_latency"
+CONF_SUBSCRIBE_LATENCY = "subscribe_latency"
+CONF_QUEUE_WAIT = "queue_wait"
+CONF_QUEUE_HIGH_WATER = "queue_high_water"
+CONF_DROPPED_COMMANDS = "dropped_commands"
+CONF_TIME_TO_FIRST_STATE = "time_to_first_state"
+CONF_ERROR_MASK = "error_mask"
+
+# Freshness slot and ``AT+SUB`` target backing each sensor.  Sensors fed by the
+# same response share a slot, so their ``poll_interval`` and ``subscribe``
+# options are merged.
+_QUERY_TARGETS = {
+    CONF_TEMPERATURE: ("TEMPERATURE", '"+TEMP"'),
+    CONF_TEMPERATURE_HIGH: ("TEMPERATURE", '"+TEMP"'),
+    CONF_TEMPERATURE_LOW: ("TEMPERATURE", '"+TEMP"'),
+    CONF_EMETER_POWER: ("EMETER_POWER", '"+EMETERPOWER"'),
+    CONF_EMETER_SESSION_TIME: ("EMETER_SESSION_TIME", '"+EMETERSESTIME"'),
+    CONF_EMETER_CHARGING_TIME: ("EMETER_CHARGING_TIME", '"+EMETERCHTIME"'),
+    CONF_UPTIME: ("UPTIME", '"+UPTIME"'),
+    CONF_HEAP_USED: ("HEAP", '"+HEAP"'),
+    CONF_HEAP_TOTAL: ("HEAP", '"+HEAP"'),
+    CONF_ENERGY_CONSUMPTION: ("ENERGY_CONSUMPTION", '"+EMETERCONSUM"'),
+    CONF_TOTAL_ENERGY_CONSUMPTION: ("TOTAL_ENERGY_CONSUMPTION", '"+EMETERTOTCONSUM"'),
+    # Integrated from the power readings, so it follows the power stream.
+    CONF_SESSION_ENERGY: ("EMETER_POWER", '"+EMETERPOWER"'),
+    CONF_VOLTAGE_L1: ("VOLTAGE", '"+EMETERVOLTAGE"'),
+    CONF_VOLTAGE_L2: ("VOLTAGE", '"+EMETERVOLTAGE"'),
+    CONF_VOLTAGE_L3: ("VOLTAGE", '"+EMETERVOLTAGE"'),
+    CONF_CURRENT_L1: ("CURRENT", '"+EMETERCURRENT"'),
+    CONF_CURRENT_L2: ("CURRENT", '"+EMETERCURRENT"'),
+    CONF_CURRENT_L3: ("CURRENT", '"+EMETERCURRENT"'),
+    CONF_WIFI_RSSI: ("WIFI_STATUS", '"+WIFISTACONN"'),
+    CONF_ERROR_MASK: ("ERROR_FLAGS", '"+ERROR"'),
+}
+
+# Options every sensor accepts on top of the regular ESPHome sensor schema.
+_SENSOR_OPTIONS_SCHEMA = QUERY_OPTIONS_SCHEMA.extend(PUBLISH_FILTER_SCHEMA)
+
+# Link diagnostics computed by the component itself; they are published on
+# every update and never polled from the EVSE.
+_LATENCY_SENSOR_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    icon="mdi:timer-sand",
+    device_class=DEVICE_CLASS_DURATION,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    accuracy_decimals=0,
+)
+_DIAGNOSTIC_SENSORS = {
+    CONF_QUERY_LATENCY: "QUERY_LATENCY",
+    CONF_WRITE_LATENCY: "WRITE_LATENCY",
+    CONF_SUBSCRIBE_LATENCY: "SUBSCRIBE_LATENCY",
+    CONF_QUEUE_WAIT: "QUEUE_WAIT",
+    CONF_QUEUE_HIGH_WATER: "QUEUE_HIGH_WATER",
+    CONF_DROPPED_COMMANDS: "DROPPED_COMMANDS",
+    CONF_TIME_TO_FIRST_STATE: "TIME_TO_FIRST_STATE",
+}
+
+# ``EntityId`` of each sensor fed by the EVSE.  The legacy ``temperature`` key
+# stands in for ``temperature_high`` when that one is absent.
+_SENSOR_ENTITIES = {
+    CONF_TEMPERATURE_HIGH: "TEMPERATURE_HIGH",
+    CONF_TEMPERATURE_LOW: "TEMPERATURE_LOW",
+    CONF_EMETER_POWER: "EMETER_POWER",
+    CONF_EMETER_SESSION_TIME: "EMETER_SESSION_TIME",
+    CONF_EMETER_CHARGING_TIME: "EMETER_CHARGING_TIME",
+    CONF_UPTIME: "UPTIME",
+    CONF_HEAP_USED: "HEAP_USED",
+    CONF_HEAP_TOTAL: "HEAP_TOTAL",
+    CONF_ENERGY_CONSUMPTION: "ENERGY_CONSUMPTION",
+    CONF_TOTAL_ENERGY_CONSUMPTION: "TOTAL_ENERGY_CONSUMPTION",
+    CONF_SESSION_ENERGY: "SESSION_ENERGY",
+    CONF_VOLTAGE_L1: "VOLTAGE_L1",
+    CONF_VOLTAGE_L2: "VOLTAGE_L2",
+    CONF_VOLTAGE_L3: "VOLTAGE_L3",
+    CONF_CURRENT_L1: "CURRENT_L1",
+    CONF_CURRENT_L2: "CURRENT_L2",
+    CONF_CURRENT_L3: "CURRENT_L3",
+    CONF_WIFI_RSSI: "WIFI_RSSI",
+    CONF_ERROR_MASK: "ERROR_MASK",
+    **_DIAGNOSTIC_SENSORS,
+}
 
 
 # Describe the optional YAML keys that create sensors.  We require at least one
@@ -69,7 +162,7 @@ CONFIG_SCHEMA = cv.All(
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=2,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_TEMPERATURE_LOW): sensor.sensor_schema(
                 unit_of_measurement=UNIT_CELSIUS,
                 icon=ICON_THERMOMETER,
@@ -77,7 +170,7 @@ CONFIG_SCHEMA = cv.All(
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=2,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_TEMPERATURE): sensor.sensor_schema(
                 unit_of_measurement=UNIT_CELSIUS,
                 icon=ICON_THERMOMETER,
@@ -85,106 +178,135 @@ CONFIG_SCHEMA = cv.All(
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=2,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_EMETER_POWER): sensor.sensor_schema(
                 device_class=DEVICE_CLASS_POWER,
                 state_class=STATE_CLASS_MEASUREMENT,
                 unit_of_measurement="W",
                 icon=ICON_FLASH,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_EMETER_SESSION_TIME): sensor.sensor_schema(
                 unit_of_measurement=UNIT_SECOND,
                 icon=ICON_TIMER,
                 state_class=STATE_CLASS_TOTAL_INCREASING,
                 device_class=DEVICE_CLASS_DURATION,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_EMETER_CHARGING_TIME): sensor.sensor_schema(
                 unit_of_measurement=UNIT_SECOND,
                 icon=ICON_TIMER,
                 state_class=STATE_CLASS_TOTAL_INCREASING,
                 device_class=DEVICE_CLASS_DURATION,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_UPTIME): sensor.sensor_schema(
                 unit_of_measurement=UNIT_SECOND,
                 icon=ICON_TIMER,
                 state_class=STATE_CLASS_TOTAL_INCREASING,
                 device_class=DEVICE_CLASS_DURATION,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_HEAP_USED): sensor.sensor_schema(
                 unit_of_measurement="B",
                 icon="mdi:memory",
                 state_class=STATE_CLASS_MEASUREMENT,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_HEAP_TOTAL): sensor.sensor_schema(
                 unit_of_measurement="B",
                 icon="mdi:memory",
                 state_class=STATE_CLASS_MEASUREMENT,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_ENERGY_CONSUMPTION): sensor.sensor_schema(
                 unit_of_measurement=UNIT_WATT_HOUR,
                 icon="mdi:counter",
                 device_class=DEVICE_CLASS_ENERGY,
                 state_class=STATE_CLASS_TOTAL_INCREASING,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_TOTAL_ENERGY_CONSUMPTION): sensor.sensor_schema(
                 unit_of_measurement=UNIT_WATT_HOUR,
                 icon="mdi:counter",
                 device_class=DEVICE_CLASS_ENERGY,
                 state_class=STATE_CLASS_TOTAL,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
+            cv.Optional(CONF_SESSION_ENERGY): sensor.sensor_schema(
+                unit_of_measurement=UNIT_WATT_HOUR,
+                icon="mdi:counter",
+                device_class=DEVICE_CLASS_ENERGY,
+                state_class=STATE_CLASS_TOTAL_INCREASING,
+                accuracy_decimals=2,
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_VOLTAGE_L1): sensor.sensor_schema(
                 unit_of_measurement=UNIT_VOLT,
                 icon="mdi:alpha-v-circle",
                 device_class=DEVICE_CLASS_VOLTAGE,
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=1,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_VOLTAGE_L2): sensor.sensor_schema(
                 unit_of_measurement=UNIT_VOLT,
                 icon="mdi:alpha-v-circle",
                 device_class=DEVICE_CLASS_VOLTAGE,
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=1,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_VOLTAGE_L3): sensor.sensor_schema(
                 unit_of_measurement=UNIT_VOLT,
                 icon="mdi:alpha-v-circle",
                 device_class=DEVICE_CLASS_VOLTAGE,
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=1,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_CURRENT_L1): sensor.sensor_schema(
                 unit_of_measurement=UNIT_AMPERE,
                 icon="mdi:alpha-a-circle",
                 device_class=DEVICE_CLASS_CURRENT,
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=1,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_CURRENT_L2): sensor.sensor_schema(
                 unit_of_measurement=UNIT_AMPERE,
                 icon="mdi:alpha-a-circle",
                 device_class=DEVICE_CLASS_CURRENT,
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=1,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_CURRENT_L3): sensor.sensor_schema(
                 unit_of_measurement=UNIT_AMPERE,
                 icon="mdi:alpha-a-circle",
                 device_class=DEVICE_CLASS_CURRENT,
                 state_class=STATE_CLASS_MEASUREMENT,
                 accuracy_decimals=1,
-            ),
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
             cv.Optional(CONF_WIFI_RSSI): sensor.sensor_schema(
                 unit_of_measurement=UNIT_DECIBEL_MILLIWATT,
                 icon="mdi:wifi",
                 device_class=DEVICE_CLASS_SIGNAL_STRENGTH,
                 state_class=STATE_CLASS_MEASUREMENT,
                 entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
+            cv.Optional(CONF_QUERY_LATENCY): _LATENCY_SENSOR_SCHEMA,
+            cv.Optional(CONF_WRITE_LATENCY): _LATENCY_SENSOR_SCHEMA,
+            cv.Optional(CONF_SUBSCRIBE_LATENCY): _LATENCY_SENSOR_SCHEMA,
+            cv.Optional(CONF_QUEUE_WAIT): _LATENCY_SENSOR_SCHEMA,
+            cv.Optional(CONF_QUEUE_HIGH_WATER): sensor.sensor_schema(
+                icon="mdi:tray-full",
+                state_class=STATE_CLASS_MEASUREMENT,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+                accuracy_decimals=0,
             ),
+            cv.Optional(CONF_DROPPED_COMMANDS): sensor.sensor_schema(
+                icon="mdi:tray-remove",
+                state_class=STATE_CLASS_TOTAL_INCREASING,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+                accuracy_decimals=0,
+            ),
+            cv.Optional(CONF_TIME_TO_FIRST_STATE): _LATENCY_SENSOR_SCHEMA,
+            cv.Optional(CONF_ERROR_MASK): sensor.sensor_schema(
+                icon="mdi:alert-circle-outline",
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+                accuracy_decimals=0,
+            ).extend(_SENSOR_OPTIONS_SCHEMA),
         }
     ),
     cv.has_at_least_one_key(
@@ -199,6 +321,7 @@ CONFIG_SCHEMA = cv.All(
         CONF_HEAP_TOTAL,
         CONF_ENERGY_CONSUMPTION,
         CONF_TOTAL_ENERGY_CONSUMPTION,
+        CONF_SESSION_ENERGY,
         CONF_VOLTAGE_L1,
         CONF_VOLTAGE_L2,
         CONF_VOLTAGE_L3,
@@ -206,6 +329,8 @@ CONFIG_SCHEMA = cv.All(
         CONF_CURRENT_L2,
         CONF_CURRENT_L3,
         CONF_WIFI_RSSI,
+        CONF_ERROR_MASK,
+        *_DIAGNOSTIC_SENSORS,
     ),
 )
 
@@ -214,62 +339,15 @@ async def to_code(config):
     """Instantiate the configured sensors and attach them to the EVSE component."""
 
     parent = await cg.get_variable(config[CONF_ESP32EVSE_ID])
+    register_query_options(parent, config, _QUERY_TARGETS)
 
-    if temperature_high_config := config.get(CONF_TEMPERATURE_HIGH):
-        # Report the highest measured board temperature for diagnostics.
-        sens = await sensor.new_sensor(temperature_high_config)
-        cg.add(parent.set_temperature_high_sensor(sens))
-    elif temperature_config := config.get(CONF_TEMPERATURE):
+    if CONF_TEMPERATURE_HIGH not in config and (temperature_config := config.get(CONF_TEMPERATURE)):
         # Backwards compatibility: treat a single temperature sensor as the
         # "high" reading so existing configurations keep working.
         sens = await sensor.new_sensor(temperature_config)
-        cg.add(parent.set_temperature_high_sensor(sens))
-    if temperature_low_config := config.get(CONF_TEMPERATURE_LOW):
-        # The lower temperature probe is optional but useful for thermal trends.
-        sens = await sensor.new_sensor(temperature_low_config)
-        cg.add(parent.set_temperature_low_sensor(sens))
-    if power_config := config.get(CONF_EMETER_POWER):
-        sens = await sensor.new_sensor(power_config)
-        cg.add(parent.set_emeter_power_sensor(sens))
-    if session_config := config.get(CONF_EMETER_SESSION_TIME):
-        sens = await sensor.new_sensor(session_config)
-        cg.add(parent.set_emeter_session_time_sensor(sens))
-    if charging_config := config.get(CONF_EMETER_CHARGING_TIME):
-        sens = await sensor.new_sensor(charging_config)
-        cg.add(parent.set_emeter_charging_time_sensor(sens))
-    if uptime_config := config.get(CONF_UPTIME):
-        sens = await sensor.new_sensor(uptime_config)
-        cg.add(parent.set_uptime_sensor(sens))
-    if heap_used_config := config.get(CONF_HEAP_USED):
-        sens = await sensor.new_sensor(heap_used_config)
-        cg.add(parent.set_heap_used_sensor(sens))
-    if heap_total_config := config.get(CONF_HEAP_TOTAL):
-        sens = await sensor.new_sensor(heap_total_config)
-        cg.add(parent.set_heap_total_sensor(sens))
-    if energy_config := config.get(CONF_ENERGY_CONSUMPTION):
-        sens = await sensor.new_sensor(energy_config)
-        cg.add(parent.set_energy_consumption_sensor(sens))
-    if total_energy_config := config.get(CONF_TOTAL_ENERGY_CONSUMPTION):
-        sens = await sensor.new_sensor(total_energy_config)
-        cg.add(parent.set_total_energy_consumption_sensor(sens))
-    if voltage_l1_config := config.get(CONF_VOLTAGE_L1):
-        sens = await sensor.new_sensor(voltage_l1_config)
-        cg.add(parent.set_voltage_l1_sensor(sens))
-    if voltage_l2_config := config.get(CONF_VOLTAGE_L2):
-        sens = await sensor.new_sensor(voltage_l2_config)
-        cg.add(parent.set_voltage_l2_sensor(sens))
-    if voltage_l3_config := config.get(CONF_VOLTAGE_L3):
-        sens = await sensor.new_sensor(voltage_l3_config)
-        cg.add(parent.set_voltage_l3_sensor(sens))
-    if current_l1_config := config.get(CONF_CURRENT_L1):
-        sens = await sensor.new_sensor(current_l1_config)
-        cg.add(parent.set_current_l1_sensor(sens))
-    if current_l2_config := config.get(CONF_CURRENT_L2):
-        sens = await sensor.new_sensor(current_l2_config)
-        cg.add(parent.set_current_l2_sensor(sens))
-    if current_l3_config := config.get(CONF_CURRENT_L3):
-        sens = await sensor.new_sensor(current_l3_config)
-        cg.add(parent.set_current_l3_sensor(sens))
-    if wifi_rssi_config := config.get(CONF_WIFI_RSSI):
-        sens = await sensor.new_sensor(wifi_rssi_config)
-        cg.add(parent.set_wifi_rssi_sensor(sens))
+        register_entity(parent, "TEMPERATURE_HIGH", sens)
+    for key, entity_id in _SENSOR_ENTITIES.items():
+        if sensor_config := config.get(key):
+            sens = await sensor.new_sensor(sensor_config)
+            register_entity(parent, entity_id, sens)
+    await register_publish_filters(parent, config, _QUERY_TARGETS)
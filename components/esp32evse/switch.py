@@ -7,7 +7,16 @@ from esphome.components import switch
 import esphome.config_validation as cv
 from esphome.const import ENTITY_CATEGORY_CONFIG
 
-from . import CONF_ESP32EVSE_ID, ESP32EVSEComponent, esp32evse_ns
+from . import (
+    CONF_ESP32EVSE_ID,
+    OPTIMISTIC_SCHEMA,
+    QUERY_OPTIONS_SCHEMA,
+    ESP32EVSEComponent,
+    esp32evse_ns,
+    register_entity,
+    register_optimistic,
+    register_query_options,
+)
 
 DEPENDENCIES = ["esp32evse"]
 
@@ -27,6 +36,14 @@ CONF_AVAILABLE = "available"
 CONF_REQUEST_AUTHORIZATION = "request_authorization"
 CONF_THREE_PHASE_METER = "three_phase_meter"
 
+# Freshness slot and ``AT+SUB`` target backing each switch.
+_QUERY_TARGETS = {
+    CONF_ENABLE: ("ENABLE", '"+ENABLE"'),
+    CONF_AVAILABLE: ("AVAILABLE", '"+AVAILABLE"'),
+    CONF_REQUEST_AUTHORIZATION: ("REQUEST_AUTHORIZATION", '"+REQAUTH"'),
+    CONF_THREE_PHASE_METER: ("EMETER_THREE_PHASE", '"+EMETERTHREEPHASE"'),
+}
+
 
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
@@ -38,27 +55,27 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_ENABLE): switch.switch_schema(
                 ESP32EVSEEnableSwitch,
                 icon="mdi:power-plug-battery-outline",
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA).extend(OPTIMISTIC_SCHEMA),
             # Available lets operators mark the charger as ready for clients.
             cv.Optional(CONF_AVAILABLE): switch.switch_schema(
                 ESP32EVSEAvailableSwitch,
                 icon="mdi:progress-wrench",
                 entity_category=ENTITY_CATEGORY_CONFIG,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA).extend(OPTIMISTIC_SCHEMA),
             # Request authorization toggles whether clients must present an
             # RFID card or similar credential before charging starts.
             cv.Optional(CONF_REQUEST_AUTHORIZATION): switch.switch_schema(
                 ESP32EVSERequestAuthorizationSwitch,
                 icon="mdi:hand-back-left-outline",
                 entity_category=ENTITY_CATEGORY_CONFIG,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA).extend(OPTIMISTIC_SCHEMA),
             # Three-Phase metering for proper enegry calculations. For the case
             # when you trip down phases 2 and 3 and would like to do One-Phase charging.
             cv.Optional(CONF_THREE_PHASE_METER): switch.switch_schema(
                 ESP32EVSEEmeterThreePhaseSwitch,
                 icon="mdi:numeric-3-circle",
                 entity_category=ENTITY_CATEGORY_CONFIG,
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA).extend(OPTIMISTIC_SCHEMA),
         }
     ),
     # Avoid generating empty switch groups by requiring at least one entry.
@@ -67,25 +84,24 @@ CONFIG_SCHEMA = cv.All(
     ),
 )
 
+# ``EntityId`` of each switch.
+_SWITCH_ENTITIES = {
+    CONF_ENABLE: "ENABLE",
+    CONF_AVAILABLE: "AVAILABLE",
+    CONF_REQUEST_AUTHORIZATION: "REQUEST_AUTHORIZATION",
+    CONF_THREE_PHASE_METER: "EMETER_THREE_PHASE",
+}
+
 
 async def to_code(config):
     """Create the configured switches and bind them to the EVSE component."""
 
     parent = await cg.get_variable(config[CONF_ESP32EVSE_ID])
+    register_query_options(parent, config, _QUERY_TARGETS)
 
-    if enable_config := config.get(CONF_ENABLE):
-        sw = await switch.new_switch(enable_config)
-        await cg.register_parented(sw, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_enable_switch(sw))
-    if available_config := config.get(CONF_AVAILABLE):
-        sw = await switch.new_switch(available_config)
-        await cg.register_parented(sw, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_available_switch(sw))
-    if req_auth_config := config.get(CONF_REQUEST_AUTHORIZATION):
-        sw = await switch.new_switch(req_auth_config)
-        await cg.register_parented(sw, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_request_authorization_switch(sw))
-    if three_phase_config := config.get(CONF_THREE_PHASE_METER):
-        sw = await switch.new_switch(three_phase_config)
-        await cg.register_parented(sw, config[CONF_ESP32EVSE_ID])
-        cg.add(parent.set_emeter_three_phase_switch(sw))
+    for key, entity_id in _SWITCH_ENTITIES.items():
+        if switch_config := config.get(key):
+            sw = await switch.new_switch(switch_config)
+            await cg.register_parented(sw, config[CONF_ESP32EVSE_ID])
+            register_entity(parent, entity_id, sw)
+    await register_optimistic(config, _QUERY_TARGETS)
@@ -7,7 +7,13 @@ from esphome.components import text_sensor
 import esphome.config_validation as cv
 from esphome.const import ENTITY_CATEGORY_DIAGNOSTIC
 
-from . import CONF_ESP32EVSE_ID, ESP32EVSEComponent
+from . import (
+    CONF_ESP32EVSE_ID,
+    QUERY_OPTIONS_SCHEMA,
+    ESP32EVSEComponent,
+    register_entity,
+    register_query_options,
+)
 
 DEPENDENCIES = ["esp32evse"]
 
@@ -21,6 +27,21 @@ CONF_WIFI_STA_SSID = "wifi_sta_ssid"
 CONF_WIFI_STA_IP = "wifi_sta_ip"
 CONF_WIFI_STA_MAC = "wifi_sta_mac"
 CONF_DEVICE_NAME = "device_name"
+CONF_LINK_STATE = "link_state"
+
+# Freshness slot and ``AT+SUB`` target backing each text sensor.
+_QUERY_TARGETS = {
+    CONF_STATE: ("STATE", '"+STATE"'),
+    CONF_CHIP: ("CHIP", '"+CHIP"'),
+    CONF_VERSION: ("VERSION", '"+VER"'),
+    CONF_IDF_VERSION: ("IDF_VERSION", '"+IDFVER"'),
+    CONF_BUILD_TIME: ("BUILD_TIME", '"+BUILDTIME"'),
+    CONF_DEVICE_TIME: ("DEVICE_TIME", '"+TIME"'),
+    CONF_WIFI_STA_SSID: ("WIFI_STA_CFG", '"+WIFISTACFG"'),
+    CONF_WIFI_STA_IP: ("WIFI_STA_IP", '"+WIFISTAIP"'),
+    CONF_WIFI_STA_MAC: ("WIFI_STA_MAC", '"+WIFISTAMAC"'),
+    CONF_DEVICE_NAME: ("DEVICE_NAME", '"+DEVNAME"'),
+}
 
 
 CONFIG_SCHEMA = cv.All(
@@ -29,33 +50,38 @@ CONFIG_SCHEMA = cv.All(
             # Tie all text sensors back to the parent C++ component instance.
             cv.GenerateID(CONF_ESP32EVSE_ID): cv.use_id(ESP32EVSEComponent),
             # Publish the EVSE state machine code so dashboards can show it.
-            cv.Optional(CONF_STATE): text_sensor.text_sensor_schema(icon="mdi:ev-station"),
+            cv.Optional(CONF_STATE): text_sensor.text_sensor_schema(icon="mdi:ev-station").extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_CHIP): text_sensor.text_sensor_schema(
                 icon="mdi:chip", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_VERSION): text_sensor.text_sensor_schema(
                 icon="mdi:tag", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_IDF_VERSION): text_sensor.text_sensor_schema(
                 icon="mdi:alpha-i-circle", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_BUILD_TIME): text_sensor.text_sensor_schema(
                 icon="mdi:clock-outline", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_DEVICE_TIME): text_sensor.text_sensor_schema(
                 icon="mdi:clock", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_WIFI_STA_SSID): text_sensor.text_sensor_schema(
                 icon="mdi:wifi", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_WIFI_STA_IP): text_sensor.text_sensor_schema(
                 icon="mdi:ip-network", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_WIFI_STA_MAC): text_sensor.text_sensor_schema(
                 icon="mdi:server-network-outline", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
-            ),
+            ).extend(QUERY_OPTIONS_SCHEMA),
             cv.Optional(CONF_DEVICE_NAME): text_sensor.text_sensor_schema(
                 icon="mdi:label-outline", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
+            ).extend(QUERY_OPTIONS_SCHEMA),
+            # Health of the UART link (UP, DEGRADED or DOWN) as seen by this
+            # component; it is not queried from the EVSE.
+            cv.Optional(CONF_LINK_STATE): text_sensor.text_sensor_schema(
+                icon="mdi:serial-port", entity_category=ENTITY_CATEGORY_DIAGNOSTIC
             ),
         }
     ),
@@ -70,42 +96,33 @@ CONFIG_SCHEMA = cv.All(
         CONF_WIFI_STA_IP,
         CONF_WIFI_STA_MAC,
         CONF_DEVICE_NAME,
+        CONF_LINK_STATE,
     ),
 )
 
+# ``EntityId`` of each text sensor.
+_TEXT_SENSOR_ENTITIES = {
+    CONF_STATE: "STATE",
+    CONF_CHIP: "CHIP",
+    CONF_VERSION: "VERSION",
+    CONF_IDF_VERSION: "IDF_VERSION",
+    CONF_BUILD_TIME: "BUILD_TIME",
+    CONF_DEVICE_TIME: "DEVICE_TIME",
+    CONF_WIFI_STA_SSID: "WIFI_STA_SSID",
+    CONF_WIFI_STA_IP: "WIFI_STA_IP",
+    CONF_WIFI_STA_MAC: "WIFI_STA_MAC",
+    CONF_DEVICE_NAME: "DEVICE_NAME",
+    CONF_LINK_STATE: "LINK_STATE",
+}
+
 
 async def to_code(config):
     """Create the configured text sensors and bind them to the component."""
 
     parent = await cg.get_variable(config[CONF_ESP32EVSE_ID])
+    register_query_options(parent, config, _QUERY_TARGETS)
 
-    if state_config := config.get(CONF_STATE):
-        sens = await text_sensor.new_text_sensor(state_config)
-        cg.add(parent.set_state_text_sensor(sens))
-    if chip_config := config.get(CONF_CHIP):
-        sens = await text_sensor.new_text_sensor(chip_config)
-        cg.add(parent.set_chip_text_sensor(sens))
-    if version_config := config.get(CONF_VERSION):
-        sens = await text_sensor.new_text_sensor(version_config)
-        cg.add(parent.set_version_text_sensor(sens))
-    if idf_version_config := config.get(CONF_IDF_VERSION):
-        sens = await text_sensor.new_text_sensor(idf_version_config)
-        cg.add(parent.set_idf_version_text_sensor(sens))
-    if build_time_config := config.get(CONF_BUILD_TIME):
-        sens = await text_sensor.new_text_sensor(build_time_config)
-        cg.add(parent.set_build_time_text_sensor(sens))
-    if device_time_config := config.get(CONF_DEVICE_TIME):
-        sens = await text_sensor.new_text_sensor(device_time_config)
-        cg.add(parent.set_device_time_text_sensor(sens))
-    if wifi_ssid_config := config.get(CONF_WIFI_STA_SSID):
-        sens = await text_sensor.new_text_sensor(wifi_ssid_config)
-        cg.add(parent.set_wifi_sta_ssid_text_sensor(sens))
-    if wifi_ip_config := config.get(CONF_WIFI_STA_IP):
-        sens = await text_sensor.new_text_sensor(wifi_ip_config)
-        cg.add(parent.set_wifi_sta_ip_text_sensor(sens))
-    if wifi_mac_config := config.get(CONF_WIFI_STA_MAC):
-        sens = await text_sensor.new_text_sensor(wifi_mac_config)
-        cg.add(parent.set_wifi_sta_mac_text_sensor(sens))
-    if device_name_config := config.get(CONF_DEVICE_NAME):
-        sens = await text_sensor.new_text_sensor(device_name_config)
-        cg.add(parent.set_device_name_text_sensor(sens))
+    for key, entity_id in _TEXT_SENSOR_ENTITIES.items():
+        if sensor_config := config.get(key):
+            sens = await text_sensor.new_text_sensor(sensor_config)
+            register_entity(parent, entity_id, sens)
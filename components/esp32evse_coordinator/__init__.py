@@ -0,0 +1,155 @@
+"""Run several ESP32 EVSE chargers from one ESPHome node.
+
+The coordinator takes over polling from the listed ``esp32evse`` instances and
+spreads their polls evenly across its own ``update_interval``.  It can also
+publish site-wide totals of the chargers' meters.
+"""
+
+import esphome.automation as automation
+import esphome.codegen as cg
+from esphome.components import sensor
+from esphome.components.esp32evse import (
+    ESP32EVSEComponent,
+    _clamp_update_interval,
+)
+import esphome.config_validation as cv
+from esphome.const import (
+    CONF_ID,
+    DEVICE_CLASS_CURRENT,
+    DEVICE_CLASS_ENERGY,
+    DEVICE_CLASS_POWER,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_FLASH,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_AMPERE,
+)
+
+try:
+    from esphome.const import UNIT_WATT_HOUR
+except ImportError:
+    from esphome.const import UNIT_WATT_HOURS as UNIT_WATT_HOUR
+
+AUTO_LOAD = ["sensor"]
+DEPENDENCIES = ["esp32evse"]
+CODEOWNERS = ["@nagyrobi"]
+
+esp32evse_coordinator_ns = cg.esphome_ns.namespace("esp32evse_coordinator")
+ESP32EVSECoordinator = esp32evse_coordinator_ns.class_(
+    "ESP32EVSECoordinator", cg.PollingComponent
+)
+ESP32EVSECoordinatorForceUpdateAction = esp32evse_coordinator_ns.class_(
+    "ESP32EVSECoordinatorForceUpdateAction",
+    automation.Action,
+    cg.Parented.template(ESP32EVSECoordinator),
+)
+
+CONF_CHARGERS = "chargers"
+CONF_POWER = "power"
+CONF_CURRENT_L1 = "current_l1"
+CONF_CURRENT_L2 = "current_l2"
+CONF_CURRENT_L3 = "current_l3"
+CONF_ENERGY_CONSUMPTION = "energy_consumption"
+CONF_TOTAL_ENERGY_CONSUMPTION = "total_energy_consumption"
+CONF_CHARGERS_ONLINE = "chargers_online"
+
+
+def _validate_unique_chargers(value):
+    seen = set()
+    for charger_id in value:
+        if charger_id in seen:
+            raise cv.Invalid(f"Charger '{charger_id}' is listed more than once")
+        seen.add(charger_id)
+    return value
+
+
+_CURRENT_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_AMPERE,
+    icon="mdi:alpha-a-circle",
+    device_class=DEVICE_CLASS_CURRENT,
+    state_class=STATE_CLASS_MEASUREMENT,
+    accuracy_decimals=1,
+)
+
+# Sensor keys and the C++ setters that attach them.
+_TOTAL_SENSORS = {
+    CONF_POWER: "set_power_sensor",
+    CONF_CURRENT_L1: "set_current_l1_sensor",
+    CONF_CURRENT_L2: "set_current_l2_sensor",
+    CONF_CURRENT_L3: "set_current_l3_sensor",
+    CONF_ENERGY_CONSUMPTION: "set_energy_consumption_sensor",
+    CONF_TOTAL_ENERGY_CONSUMPTION: "set_total_energy_consumption_sensor",
+    CONF_CHARGERS_ONLINE: "set_chargers_online_sensor",
+}
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ESP32EVSECoordinator),
+            # Polled in this order, each one ``update_interval / n`` after the
+            # previous.  Their own ``update_interval`` is ignored.
+            cv.Required(CONF_CHARGERS): cv.All(
+                cv.ensure_list(cv.use_id(ESP32EVSEComponent)),
+                cv.Length(min=1),
+                _validate_unique_chargers,
+            ),
+            cv.Optional(CONF_POWER): sensor.sensor_schema(
+                device_class=DEVICE_CLASS_POWER,
+                state_class=STATE_CLASS_MEASUREMENT,
+                unit_of_measurement="W",
+                icon=ICON_FLASH,
+            ),
+            cv.Optional(CONF_CURRENT_L1): _CURRENT_SCHEMA,
+            cv.Optional(CONF_CURRENT_L2): _CURRENT_SCHEMA,
+            cv.Optional(CONF_CURRENT_L3): _CURRENT_SCHEMA,
+            # Growth of the chargers' session counters since boot, so it never
+            # drops when one of them starts a new session.
+            cv.Optional(CONF_ENERGY_CONSUMPTION): sensor.sensor_schema(
+                unit_of_measurement=UNIT_WATT_HOUR,
+                icon="mdi:counter",
+                device_class=DEVICE_CLASS_ENERGY,
+                state_class=STATE_CLASS_TOTAL_INCREASING,
+            ),
+            cv.Optional(CONF_TOTAL_ENERGY_CONSUMPTION): sensor.sensor_schema(
+                unit_of_measurement=UNIT_WATT_HOUR,
+                icon="mdi:counter",
+                device_class=DEVICE_CLASS_ENERGY,
+                state_class=STATE_CLASS_TOTAL,
+            ),
+            cv.Optional(CONF_CHARGERS_ONLINE): sensor.sensor_schema(
+                icon="mdi:ev-station",
+                state_class=STATE_CLASS_MEASUREMENT,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+                accuracy_decimals=0,
+            ),
+        }
+    ).extend(cv.polling_component_schema("60000ms")),
+    _clamp_update_interval,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    for charger_id in config[CONF_CHARGERS]:
+        charger = await cg.get_variable(charger_id)
+        cg.add(var.add_charger(charger))
+    for key, setter in _TOTAL_SENSORS.items():
+        if sensor_config := config.get(key):
+            sens = await sensor.new_sensor(sensor_config)
+            cg.add(getattr(var, setter)(sens))
+
+
+@automation.register_action(
+    "esp32evse_coordinator.force_update",
+    ESP32EVSECoordinatorForceUpdateAction,
+    automation.maybe_simple_id(
+        {cv.GenerateID(): cv.use_id(ESP32EVSECoordinator)}
+    ),
+    synchronous=True,
+)
+async def force_update_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
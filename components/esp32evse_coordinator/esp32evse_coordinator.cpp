@@ -0,0 +1,141 @@
+// Shared poll scheduler and site-wide totals for several ESP32 EVSE chargers.
+#include "esp32evse_coordinator.h"
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <cmath>
+#include <inttypes.h>
+
+namespace esphome {
+namespace esp32evse_coordinator {
+
+static const char *const TAG = "esp32evse_coordinator";
+
+using FreshnessSlot = ESP32EVSEComponent::FreshnessSlot;
+using LinkState = ESP32EVSEComponent::LinkState;
+
+void ESP32EVSECoordinator::add_charger(ESP32EVSEComponent *charger) {
+  this->chargers_.push_back(charger);
+  this->last_session_wh_.push_back(-1);
+}
+
+void ESP32EVSECoordinator::setup() {
+  for (auto *charger : this->chargers_) {
+    // From here on the charger only polls when its slot comes up.  It keeps
+    // the shared interval so its freshness tracking matches the real cadence.
+    charger->stop_poller();
+    charger->set_update_interval(this->get_update_interval());
+    if (this->power_sensor_ != nullptr)
+      charger->require_slot(FreshnessSlot::EMETER_POWER);
+    if (this->current_sensors_[0] != nullptr || this->current_sensors_[1] != nullptr ||
+        this->current_sensors_[2] != nullptr)
+      charger->require_slot(FreshnessSlot::CURRENT);
+    if (this->energy_consumption_sensor_ != nullptr)
+      charger->require_slot(FreshnessSlot::ENERGY_CONSUMPTION);
+    if (this->total_energy_consumption_sensor_ != nullptr)
+      charger->require_slot(FreshnessSlot::TOTAL_ENERGY_CONSUMPTION);
+  }
+  this->next_charger_ = this->chargers_.size();
+}
+
+void ESP32EVSECoordinator::loop() { this->poll_next_charger_(); }
+
+void ESP32EVSECoordinator::update() {
+  // Totals cover whatever arrived during the previous tick.
+  this->publish_totals_();
+  // A tick can only overrun when the main loop stalled for most of an
+  // interval; finish the stragglers instead of skipping them.
+  while (this->next_charger_ < this->chargers_.size())
+    this->chargers_[this->next_charger_++]->update();
+  this->tick_start_ms_ = millis();
+  this->next_charger_ = 0;
+  this->poll_next_charger_();
+}
+
+void ESP32EVSECoordinator::force_update() {
+  for (auto *charger : this->chargers_)
+    charger->force_update();
+}
+
+// Charger ``i`` polls ``i / n`` of the way into the tick.  At most one charger
+// is polled per loop iteration, even if several slots have passed.
+void ESP32EVSECoordinator::poll_next_charger_() {
+  if (this->next_charger_ >= this->chargers_.size())
+    return;
+  const uint32_t slot_ms = this->get_update_interval() / this->chargers_.size();
+  if (millis() - this->tick_start_ms_ < slot_ms * this->next_charger_)
+    return;
+  this->chargers_[this->next_charger_++]->update();
+}
+
+void ESP32EVSECoordinator::publish_totals_() {
+  uint32_t online = 0;
+  bool has_power = false;
+  uint64_t power_w = 0;
+  bool has_current = false;
+  std::array<int64_t, 3> current_ma{};
+  bool has_all_totals = true;
+  int64_t total_energy_wh = 0;
+
+  for (size_t i = 0; i < this->chargers_.size(); ++i) {
+    const auto *charger = this->chargers_[i];
+    const auto &readings = charger->get_meter_readings();
+    // The site total must never drop, which Home Assistant treats as a reset.
+    // A session reading below the previous one started a new session and
+    // adds nothing; the first reading of a charger is only its baseline.
+    if (readings.energy_wh.has_value()) {
+      const int64_t session_wh = *readings.energy_wh;
+      int64_t &last_wh = this->last_session_wh_[i];
+      if (last_wh >= 0 && session_wh > last_wh)
+        this->energy_wh_ += session_wh - last_wh;
+      last_wh = session_wh;
+      this->has_energy_ = true;
+    }
+    if (readings.total_energy_wh.has_value()) {
+      total_energy_wh += *readings.total_energy_wh;
+    } else {
+      has_all_totals = false;
+    }
+    if (charger->get_link_state() == LinkState::DOWN)
+      continue;
+    ++online;
+    if (readings.power_w.has_value()) {
+      has_power = true;
+      power_w += *readings.power_w;
+    }
+    if (readings.current_ma.has_value()) {
+      has_current = true;
+      for (size_t phase = 0; phase < current_ma.size(); ++phase)
+        current_ma[phase] += (*readings.current_ma)[phase];
+    }
+  }
+
+  if (this->power_sensor_ != nullptr)
+    this->power_sensor_->publish_state(has_power ? static_cast<float>(power_w) : NAN);
+  for (size_t phase = 0; phase < current_ma.size(); ++phase) {
+    if (this->current_sensors_[phase] != nullptr)
+      this->current_sensors_[phase]->publish_state(has_current ? static_cast<float>(current_ma[phase]) * 0.001f
+                                                               : NAN);
+  }
+  if (this->energy_consumption_sensor_ != nullptr && this->has_energy_)
+    this->energy_consumption_sensor_->publish_state(static_cast<float>(this->energy_wh_));
+  // A partial lifetime total would jump once the missing charger reports.
+  if (this->total_energy_consumption_sensor_ != nullptr && has_all_totals && !this->chargers_.empty())
+    this->total_energy_consumption_sensor_->publish_state(static_cast<float>(total_energy_wh));
+  if (this->chargers_online_sensor_ != nullptr)
+    this->chargers_online_sensor_->publish_state(online);
+}
+
+void ESP32EVSECoordinator::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP32EVSE Coordinator:");
+  ESP_LOGCONFIG(TAG, "  Update Interval: %" PRIu32 " ms", this->get_update_interval());
+  ESP_LOGCONFIG(TAG, "  Chargers: %u", static_cast<unsigned>(this->chargers_.size()));
+  if (!this->chargers_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Poll Stagger: %" PRIu32 " ms",
+                  static_cast<uint32_t>(this->get_update_interval() / this->chargers_.size()));
+  }
+}
+
+}  // namespace esp32evse_coordinator
+}  // namespace esphome
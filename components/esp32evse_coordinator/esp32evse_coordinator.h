@@ -0,0 +1,85 @@
+#pragma once
+
+// The coordinator only drives ``ESP32EVSEComponent`` instances through their
+// public API, so it lives in its own component next to them.
+#include "esphome/components/esp32evse/esp32evse.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/component.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace esp32evse_coordinator {
+
+using esp32evse::ESP32EVSEComponent;
+
+// Runs several chargers attached to one node from a single poll scheduler.
+// Each ``update_interval`` tick is split into one slot per charger, so their
+// queries, parsing and entity publishes are spread across the interval instead
+// of all landing on the same loop iteration.  The coordinator also sums the
+// chargers' meter readings into site-wide sensors.
+class ESP32EVSECoordinator : public PollingComponent {
+ public:
+  // Chargers are polled in the order they were added.
+  void add_charger(ESP32EVSEComponent *charger);
+  const std::vector<ESP32EVSEComponent *> &get_chargers() const { return this->chargers_; }
+
+  // Runs after the chargers so their own pollers can be stopped.
+  float get_setup_priority() const override { return setup_priority::DATA - 1.0f; }
+  void setup() override;
+  void loop() override;
+  void update() override;
+  void dump_config() override;
+  // Refresh every charger right away, bypassing the stagger.
+  void force_update();
+
+  void set_power_sensor(sensor::Sensor *sensor) { this->power_sensor_ = sensor; }
+  void set_current_l1_sensor(sensor::Sensor *sensor) { this->current_sensors_[0] = sensor; }
+  void set_current_l2_sensor(sensor::Sensor *sensor) { this->current_sensors_[1] = sensor; }
+  void set_current_l3_sensor(sensor::Sensor *sensor) { this->current_sensors_[2] = sensor; }
+  void set_energy_consumption_sensor(sensor::Sensor *sensor) { this->energy_consumption_sensor_ = sensor; }
+  void set_total_energy_consumption_sensor(sensor::Sensor *sensor) {
+    this->total_energy_consumption_sensor_ = sensor;
+  }
+  void set_chargers_online_sensor(sensor::Sensor *sensor) { this->chargers_online_sensor_ = sensor; }
+
+ protected:
+  // Poll the next charger once its slot within the current tick has come.
+  void poll_next_charger_();
+  void publish_totals_();
+
+  std::vector<ESP32EVSEComponent *> chargers_;
+  // Last session reading of each charger, ``-1`` before the first one, and the
+  // energy summed from their increases since boot.  Session counters restart
+  // with every session, so only their increases go into the site total.
+  std::vector<int64_t> last_session_wh_;
+  int64_t energy_wh_{0};
+  bool has_energy_{false};
+  // Start of the current tick and the index of the next charger to poll; the
+  // index equals ``chargers_.size()`` once everyone had their turn.
+  uint32_t tick_start_ms_{0};
+  size_t next_charger_{0};
+
+  sensor::Sensor *power_sensor_{nullptr};
+  std::array<sensor::Sensor *, 3> current_sensors_{};
+  sensor::Sensor *energy_consumption_sensor_{nullptr};
+  sensor::Sensor *total_energy_consumption_sensor_{nullptr};
+  sensor::Sensor *chargers_online_sensor_{nullptr};
+};
+
+template<typename... Ts>
+class ESP32EVSECoordinatorForceUpdateAction : public Action<Ts...>, public Parented<ESP32EVSECoordinator> {
+ public:
+  void play(const Ts &... x) override {
+    if (this->parent_ == nullptr)
+      return;
+    this->parent_->force_update();
+  }
+};
+
+}  // namespace esp32evse_coordinator
+}  // namespace esphome